@@ -0,0 +1,81 @@
+// AllocationCounter.cpp
+// Nathan Damon
+// 2026-10-16
+// The global operator new and delete that count for AllocationCounter
+//
+// Every form is replaced, the array, aligned and nothrow ones too, so no
+// allocation is missed and every delete frees with the function that
+// matches its new.
+
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	void* allocate(size_t size)
+	{
+		AllocationCounter::countAllocation();
+		return std::malloc(size == 0 ? 1 : size);
+	}
+
+	void* allocateAligned(size_t size, std::align_val_t alignment)
+	{
+		AllocationCounter::countAllocation();
+		size_t align = static_cast<size_t>(alignment);
+#ifdef _MSC_VER
+		return _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+		// aligned_alloc wants the size to be a multiple of the alignment
+		size_t rounded = (size + align - 1) / align * align;
+		return std::aligned_alloc(align, rounded == 0 ? align : rounded);
+#endif
+	}
+
+	void freeAligned(void* memory)
+	{
+#ifdef _MSC_VER
+		_aligned_free(memory);
+#else
+		std::free(memory);
+#endif
+	}
+
+	void* allocateOrThrow(size_t size)
+	{
+		if (void* memory = allocate(size))
+			return memory;
+		throw std::bad_alloc();
+	}
+
+	void* allocateAlignedOrThrow(size_t size, std::align_val_t alignment)
+	{
+		if (void* memory = allocateAligned(size, alignment))
+			return memory;
+		throw std::bad_alloc();
+	}
+}
+
+void* operator new(size_t size) { return allocateOrThrow(size); }
+void* operator new[](size_t size) { return allocateOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t& tag) noexcept { (void)tag; return allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept { (void)tag; return allocate(size); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t size) noexcept { (void)size; std::free(memory); }
+void operator delete[](void* memory, size_t size) noexcept { (void)size; std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t& tag) noexcept { (void)tag; std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t& tag) noexcept { (void)tag; std::free(memory); }
+
+void* operator new(size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment) { return allocateAlignedOrThrow(size, alignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept { (void)tag; return allocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t& tag) noexcept { (void)tag; return allocateAligned(size, alignment); }
+
+void operator delete(void* memory, std::align_val_t alignment) noexcept { (void)alignment; freeAligned(memory); }
+void operator delete[](void* memory, std::align_val_t alignment) noexcept { (void)alignment; freeAligned(memory); }
+void operator delete(void* memory, size_t size, std::align_val_t alignment) noexcept { (void)size; (void)alignment; freeAligned(memory); }
+void operator delete[](void* memory, size_t size, std::align_val_t alignment) noexcept { (void)size; (void)alignment; freeAligned(memory); }
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t& tag) noexcept { (void)alignment; (void)tag; freeAligned(memory); }
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t& tag) noexcept { (void)alignment; (void)tag; freeAligned(memory); }
@@ -0,0 +1,30 @@
+// AllocationCounter.h
+// Nathan Damon
+// 2026-10-16
+// Counts the heap allocations made by a program
+//
+// The global operator new and delete are replaced in AllocationCounter.cpp,
+// build that file into the program once. Every allocation made with new,
+// which includes the ones the standard containers make, is counted.
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+class AllocationCounter
+{
+public:
+	// Allocations since the program started, take the difference of two calls to count a section
+	static size_t getCount()
+	{
+		return _count.load(std::memory_order_relaxed);
+	}
+
+	static void countAllocation()
+	{
+		_count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+private:
+	inline static std::atomic<size_t> _count{ 0 };
+};
@@ -0,0 +1,310 @@
+// BatchHull.h
+// Nathan Damon
+// 2026-10-16
+// Convex hulls of many small point sets in one call
+//
+// The sets are given CSR style: one HullPoints holding every set's points
+// back to back, and offsets where set s is the points offsets[s] to
+// offsets[s + 1] - 1. The sets are split between the TaskPool threads and
+// the hulls go into one output buffer the same way, getHullIndices holds
+// every hull in counter clockwise order and set s's hull is
+// getHullOffsets()[s] to getHullOffsets()[s + 1] - 1. The indices are
+// into the batch's points, not the set's.
+//
+// A set of up to _smallSetSize points is copied to arrays on the stack
+// and split with the same kernels as QuickHullSoA, so it costs no
+// allocation and none of the setup of a HullEngine run. Larger sets are culled to the points outside
+// the quadrilateral of their extremes (Akl-Toussaint), sorted and walked
+// with the monotone chain in scratch buffers kept for each chunk of sets.
+// Both give the hull in the same order with no points on its edges. Once
+// the buffers have grown to a batch, a serial run of the same sizes
+// allocates nothing, a parallel run only allocates the tasks of each chunk.
+
+#pragma once
+#include "HullEngine.h"
+#include "MonotoneChainHull.h"
+#include "HullKernels.h"
+#include "TaskPool.h"
+#include <algorithm>
+
+class BatchHull
+{
+public:
+	BatchHull() {}
+	~BatchHull() {}
+
+	// Returns false when the offsets do not fit the points
+	// offsets has one more entry than there are sets, starting at 0 and never going down
+	bool computeHulls(const HullPoints& points, const std::vector<uint32_t>& offsets)
+	{
+		_hullOffsets.assign(1, 0);
+		_hullIndices.clear();
+		if (offsets.empty() || offsets.front() != 0 || offsets.back() > points.size())
+			return false;
+		for (size_t s = 1; s < offsets.size(); s++)
+		{
+			if (offsets[s] < offsets[s - 1])
+				return false;
+		}
+
+		// Each set's hull is first put in that set's own range of slots, so the sets can be done in any order
+		size_t setCount = offsets.size() - 1;
+		_hullCounts.resize(setCount);
+		_slots.resize(offsets.back());
+
+		TaskPool& pool = TaskPool::getInstance();
+		size_t chunkCount = (_parallel && offsets.back() >= _parallelThreshold) ? pool.getThreadCount() * 8 : 1;
+		if (_scratch.size() < chunkCount)
+			_scratch.resize(chunkCount);
+		auto hullSets = [&](size_t chunk, size_t begin, size_t end)
+			{
+				for (size_t s = begin; s < end; s++)
+					_hullCounts[s] = uint32_t(computeSetHull(points, offsets[s], offsets[s + 1] - offsets[s], _scratch[chunk]));
+			};
+		if (chunkCount == 1)
+			hullSets(0, 0, setCount);
+		else
+			pool.parallelFor(setCount, chunkCount, hullSets);
+
+		// Then packed one after another
+		_hullOffsets.resize(setCount + 1);
+		for (size_t s = 0; s < setCount; s++)
+			_hullOffsets[s + 1] = _hullOffsets[s] + _hullCounts[s];
+		_hullIndices.resize(_hullOffsets.back());
+		for (size_t s = 0; s < setCount; s++)
+			std::copy(_slots.begin() + offsets[s], _slots.begin() + offsets[s] + _hullCounts[s], _hullIndices.begin() + _hullOffsets[s]);
+		return true;
+	}
+
+	// Set s's hull is _hullIndices[getHullOffsets()[s]] to _hullIndices[getHullOffsets()[s + 1] - 1]
+	const std::vector<uint32_t>& getHullOffsets() const
+	{
+		return _hullOffsets;
+	}
+	const std::vector<uint32_t>& getHullIndices() const
+	{
+		return _hullIndices;
+	}
+	size_t getSetCount() const
+	{
+		return _hullOffsets.size() - 1;
+	}
+
+	// Batches with fewer points than _parallelThreshold are always run on one thread
+	void setParallel(bool parallel)
+	{
+		_parallel = parallel;
+	}
+	bool getParallel() const
+	{
+		return _parallel;
+	}
+
+private:
+	// Sets up to this size are done on the stack
+	static constexpr size_t _smallSetSize = 1024;
+	static constexpr size_t _parallelThreshold = 1 << 14;
+
+	// Buffers for the sets too large for the stack
+	struct Scratch
+	{
+		std::vector<uint32_t> _order;
+		std::vector<float> _x;
+		std::vector<float> _y;
+		std::vector<uint32_t> _hull;
+	};
+
+	// Puts the hull of the count points from first into _slots from first, returns the number of hull points
+	size_t computeSetHull(const HullPoints& points, size_t first, size_t count, Scratch& scratch)
+	{
+		const float* x = points._x.data() + first;
+		const float* y = points._y.data() + first;
+		size_t hullCount = 0;
+		if (count <= _smallSetSize)
+		{
+			uint32_t hull[_smallSetSize];
+			hullCount = computeSmallHull(x, y, count, hull);
+			for (size_t i = 0; i < hullCount; i++)
+				_slots[first + i] = uint32_t(first) + hull[i];
+			return hullCount;
+		}
+
+		scratch._order.resize(count);
+		scratch._x.resize(count);
+		scratch._y.resize(count);
+		scratch._hull.resize(count + 1);
+		size_t keptCount = cullInterior(x, y, count, scratch._order.data());
+		std::sort(scratch._order.begin(), scratch._order.begin() + keptCount, [x, y](uint32_t a, uint32_t b)
+			{
+				return x[a] < x[b] || (x[a] == x[b] && y[a] < y[b]);
+			});
+		for (size_t i = 0; i < keptCount; i++)
+		{
+			scratch._x[i] = x[scratch._order[i]];
+			scratch._y[i] = y[scratch._order[i]];
+		}
+		hullCount = MonotoneChainHull::chain(scratch._x.data(), scratch._y.data(), keptCount, scratch._hull.data());
+		for (size_t i = 0; i < hullCount; i++)
+			_slots[first + i] = uint32_t(first) + scratch._order[scratch._hull[i]];
+		return hullCount;
+	}
+
+	// A hull point of a small set, with its position in the set
+	struct Corner
+	{
+		float _x;
+		float _y;
+		uint32_t _index;
+	};
+	struct SmallSet
+	{
+		float _x[_smallSetSize];
+		float _y[_smallSetSize];
+		uint32_t _index[_smallSetSize];
+	};
+	// A range of a small set still to be split, the points in it are right of P-Q
+	struct SmallFrame
+	{
+		Corner _P;
+		Corner _Q;
+		size_t _start;
+		size_t _count;
+		size_t _farthest; // Position of the point farthest right of P-Q, found when the range was split
+		size_t _outputStart; // First of the _count hull slots for the hull points between P and Q
+	};
+	// log2(_smallSetSize) + 1 frames are the most the stack can hold
+	static constexpr size_t _maxSmallStackDepth = 16;
+	static constexpr uint32_t _emptySlot = 0xFFFFFFFF;
+
+	// QuickHull of a small set, split with the same kernels as QuickHullSoA on a copy on the stack
+	// The hull goes into hull in the same order as the monotone chain's: counter clockwise from the
+	// leftmost point, without the points on its edges. Returns the number of hull points
+	// Like QuickHullSoA, every range has as many slots of hull as it has points and a split puts its
+	// point between the slots of its two sides, so the ranges can be done in any order
+	static size_t computeSmallHull(const float* x, const float* y, size_t count, uint32_t* hull)
+	{
+		if (count == 0)
+			return 0;
+
+		// Least x with the least y and greatest x with the greatest y, like the ends of the sorted points
+		SmallSet set;
+		uint32_t A = 0;
+		uint32_t B = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			set._x[i] = x[i];
+			set._y[i] = y[i];
+			set._index[i] = i;
+			if (x[i] < x[A] || (x[i] == x[A] && y[i] < y[A]))
+				A = i;
+			if (x[i] > x[B] || (x[i] == x[B] && y[i] > y[B]))
+				B = i;
+		}
+		hull[0] = A;
+		if (x[A] == x[B] && y[A] == y[B])
+			return 1;
+
+		// The kernels' above is right of the line, so A-B takes the points below and B-A the ones above
+		Corner a = { x[A], y[A], A };
+		Corner b = { x[B], y[B], B };
+		HullKernels::SplitResult split = HullKernels::splitAboveLines(set._x, set._y, set._index, count,
+			HullLine(a._x, a._y, b._x, b._y), HullLine(b._x, b._y, a._x, a._y));
+
+		// A, the first side, B, then the second side. A and B are on neither side, so it all fits in count slots
+		const size_t secondOutput = split._firstCount + 2;
+		const size_t slotCount = secondOutput + split._secondCount;
+		std::fill(hull, hull + slotCount, _emptySlot);
+		hull[0] = A;
+		hull[secondOutput - 1] = B;
+
+		SmallFrame stack[_maxSmallStackDepth];
+		size_t stackSize = 0;
+		stack[stackSize++] = { b, a, split._firstCount, split._secondCount, split._secondFarthest, secondOutput };
+		SmallFrame frame = { a, b, 0, split._firstCount, split._firstFarthest, 1 };
+		while (true)
+		{
+			if (frame._count == 0)
+			{
+				if (stackSize == 0)
+					break;
+				frame = stack[--stackSize];
+				continue;
+			}
+
+			Corner C = { set._x[frame._farthest], set._y[frame._farthest], set._index[frame._farthest] };
+			split = HullKernels::splitAboveLines(set._x + frame._start, set._y + frame._start, set._index + frame._start, frame._count,
+				HullLine(frame._P._x, frame._P._y, C._x, C._y), HullLine(C._x, C._y, frame._Q._x, frame._Q._y));
+			hull[frame._outputStart + split._firstCount] = C._index;
+
+			// The smaller side is done next, so the stack holds at most log2 of the set's size
+			SmallFrame left = { frame._P, C, frame._start, split._firstCount, frame._start + split._firstFarthest, frame._outputStart };
+			SmallFrame right = { C, frame._Q, frame._start + split._firstCount, split._secondCount, frame._start + split._secondFarthest,
+				frame._outputStart + split._firstCount + 1 };
+			if (left._count > right._count)
+				std::swap(left, right);
+			stack[stackSize++] = right;
+			frame = left;
+		}
+
+		size_t hullCount = 0;
+		for (size_t i = 0; i < slotCount; i++)
+		{
+			if (hull[i] != _emptySlot)
+				hull[hullCount++] = hull[i];
+		}
+		return removeFlatVertices(x, y, hull, hullCount);
+	}
+
+	// Points the same distance from a line are only told apart by rounding, so a point in the middle
+	// of an edge can be picked as the farthest. A is the least point, so it is always a corner
+	static size_t removeFlatVertices(const float* x, const float* y, uint32_t* hull, size_t count)
+	{
+		return removeFlatHullVertices(hull, count, [x, y](uint32_t a, uint32_t b, uint32_t c)
+			{
+				return HullPredicates::orientation(x[a], y[a], x[b], y[b], x[c], y[c]) <= 0.0;
+			});
+	}
+
+	// Akl-Toussaint culling: a point inside the quadrilateral of the points with the least and greatest
+	// x and y can not be on the hull. Puts the rest in order and returns how many there are
+	static size_t cullInterior(const float* x, const float* y, size_t count, uint32_t* order)
+	{
+		uint32_t left = 0;
+		uint32_t bottom = 0;
+		uint32_t right = 0;
+		uint32_t top = 0;
+		for (uint32_t i = 1; i < count; i++)
+		{
+			if (x[i] < x[left]) left = i;
+			if (y[i] < y[bottom]) bottom = i;
+			if (x[i] > x[right]) right = i;
+			if (y[i] > y[top]) top = i;
+		}
+
+		// Counter clockwise, so inside is left of every side. The corners themselves are on the sides and are kept
+		const uint32_t corners[5] = { left, bottom, right, top, left };
+		size_t keptCount = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			bool inside = true;
+			for (int side = 0; side < 4 && inside; side++)
+			{
+				uint32_t a = corners[side];
+				uint32_t b = corners[side + 1];
+				inside = HullPredicates::orientation(x[a], y[a], x[b], y[b], x[i], y[i]) > 0.0;
+			}
+			if (inside == false)
+				order[keptCount++] = i;
+		}
+		return keptCount;
+	}
+
+private:
+	bool _parallel = true;
+	std::vector<Scratch> _scratch; // One for each chunk of sets
+	std::vector<uint32_t> _hullCounts;
+	std::vector<uint32_t> _slots;
+
+	std::vector<uint32_t> _hullOffsets{ 0 };
+	std::vector<uint32_t> _hullIndices;
+};
@@ -0,0 +1,276 @@
+// ChanHull.h
+// Nathan Damon
+// 2026-10-16
+// Chan's convex hull algorithm
+//
+// The points are split into groups of m points and the hull of each group
+// is found with the monotone chain. The full hull is then wrapped (Jarvis
+// march) from the leftmost point, where each step only has to find the
+// tangent of every group hull from the last hull point, which is a binary
+// search. If the hull is not closed after m steps, m is squared and it is
+// tried again, so it takes O(n log h) for h hull points.
+//
+// The points are sorted by x once and every group is a run of the sorted
+// points, so the group hulls do not need sorting of their own and the
+// groups do not overlap in x.
+
+#pragma once
+#include "MonotoneChainHull.h"
+
+class ChanHull : public HullEngine
+{
+public:
+	ChanHull() {}
+	~ChanHull() {}
+
+	std::string getName() const override
+	{
+		return "Chan";
+	}
+
+	bool computeHull(HullPoints& points, std::vector<HullEdge>& edges, std::vector<HullEdge>* debugEdges = nullptr) override
+	{
+		HullProfiler::Scope runScope(_profiler, "Chan");
+		points.clearOnHull();
+		_hullOrder.clear();
+		size_t n = points.size();
+		if (n == 0)
+			return true;
+
+		{
+			HullProfiler::Scope scope(_profiler, "sortByX");
+			_sorter.sortByX(points);
+		}
+		_x = _sorter.getSortedX();
+		_y = _sorter.getSortedY();
+		const uint32_t* sortedIndex = _sorter.getSortedIndex();
+
+		// m = 256, 65536, then every point in one group. The guesses of 4 and 16 from the
+		// paper each cost a full pass and hardly ever hold, so they are skipped
+		for (size_t t = 3; ; t++)
+		{
+			size_t groupSize = t >= 5 ? n : std::min(n, size_t(1) << (size_t(1) << t));
+			{
+				HullProfiler::Scope scope(_profiler, "buildGroupHulls");
+				buildGroupHulls(n, groupSize);
+			}
+
+			// One group is its own hull, so the last try always closes
+			HullProfiler::Scope scope(_profiler, "wrapGroups");
+			size_t maxSteps = groupSize >= n ? n + 1 : groupSize;
+			if (wrapGroups(maxSteps) || groupSize >= n)
+				break;
+		}
+
+		for (size_t i = 0; i < _result.size(); i++)
+			_hullOrder.push_back(sortedIndex[_result[i]]);
+		addHullEdges(points, edges);
+
+		// The group hulls of the last try
+		if (debugEdges)
+		{
+			for (size_t group = 0; group + 1 < _groupStart.size(); group++)
+			{
+				size_t start = _groupStart[group];
+				size_t count = _groupStart[group + 1] - start;
+				for (size_t i = 0; count > 1 && i < count; i++)
+					debugEdges->push_back({ sortedIndex[_groupHulls[start + i]], sortedIndex[_groupHulls[start + (i + 1) % count]] });
+			}
+		}
+		return true;
+	}
+
+private:
+	// A point of a group hull
+	struct Vertex
+	{
+		size_t _group;
+		size_t _vertex; // Position in the group hull
+	};
+
+	void buildGroupHulls(size_t n, size_t groupSize)
+	{
+		size_t groupCount = (n + groupSize - 1) / groupSize;
+		_groupHulls.resize(n + groupCount);
+		_groupStart.resize(groupCount + 1);
+
+		size_t hullEnd = 0;
+		for (size_t group = 0; group < groupCount; group++)
+		{
+			size_t begin = group * groupSize;
+			size_t count = std::min(groupSize, n - begin);
+			uint32_t* hull = _groupHulls.data() + hullEnd;
+
+			_groupStart[group] = hullEnd;
+			size_t hullCount = MonotoneChainHull::chain(_x + begin, _y + begin, count, hull);
+			for (size_t i = 0; i < hullCount; i++)
+				hull[i] += uint32_t(begin);
+			hullEnd += hullCount;
+		}
+		_groupStart[groupCount] = hullEnd;
+	}
+
+	// Returns false when the hull did not close within maxSteps
+	bool wrapGroups(size_t maxSteps)
+	{
+		_result.clear();
+
+		// The leftmost point is the first point of the first group hull
+		Vertex current = { 0, 0 };
+		uint32_t start = getPosition(current);
+		for (size_t step = 0; step < maxSteps; step++)
+		{
+			uint32_t p = getPosition(current);
+			_result.push_back(p);
+
+			Vertex next;
+			bool found = false;
+			for (size_t group = 0; group + 1 < _groupStart.size(); group++)
+			{
+				Vertex candidate;
+				if (group == current._group)
+				{
+					// The point is on this hull, so the tangent is the next point of it
+					size_t count = getVertexCount(group);
+					candidate = { group, (current._vertex + 1) % count };
+				}
+				else if (findTangent(group, p, candidate) == false)
+					continue;
+
+				uint32_t c = getPosition(candidate);
+				if (isSamePoint(p, c))
+					continue;
+				if (found == false || isBetterNext(p, getPosition(next), c))
+				{
+					next = candidate;
+					found = true;
+				}
+			}
+
+			// Every point is the same
+			if (found == false)
+				return true;
+			addProgressEdge(_sorter.getSortedIndex()[p], _sorter.getSortedIndex()[getPosition(next)]);
+			if (isSamePoint(getPosition(next), start))
+				return true;
+			current = next;
+		}
+		return false;
+	}
+
+	// The vertex of the group hull that every other vertex is to the left of, seen from p
+	// Returns false when the group has no vertex other than p
+	bool findTangent(size_t group, uint32_t p, Vertex& tangent)
+	{
+		size_t count = getVertexCount(group);
+		tangent._group = group;
+		if (count > 8)
+		{
+			// Turn from vertex i to the next one, seen from p. Going around the hull it
+			// turns counter clockwise up to one tangent and clockwise down to the other
+			auto turn = [&](size_t i) { return getTurn(p, group, i % count, (i + 1) % count); };
+
+			size_t found = count;
+			if (turn(count - 1) <= 0.0 && turn(0) >= 0.0)
+				found = 0;
+
+			size_t a = 0;
+			size_t b = count;
+			while (found == count && b - a > 1)
+			{
+				size_t c = (a + b) / 2;
+				double turnC = turn(c);
+				if (turn(c - 1) <= 0.0 && turnC >= 0.0)
+				{
+					found = c;
+					break;
+				}
+
+				// Keep the half the clockwise-most vertex is in. When A and C turn the same way,
+				// C is past A on the same run if it is further round in that direction
+				bool upA = turn(a) > 0.0;
+				bool upC = turnC > 0.0;
+				double cFromA = getTurn(p, group, a % count, c);
+				bool afterC = upA ? (upC == false || cFromA > 0.0) : (upC == false && cFromA < 0.0);
+				if (afterC)
+					a = c;
+				else
+					b = c;
+			}
+
+			if (found != count && turn(found + count - 1) <= 0.0 && turn(found) >= 0.0 && isSamePoint(p, getPosition(group, found)) == false)
+			{
+				// Points in line with p, take the farthest
+				for (size_t i = 0; i < count && turn(found) == 0.0 && isFarther(p, getPosition(group, (found + 1) % count), getPosition(group, found)); i++)
+					found = (found + 1) % count;
+				for (size_t i = 0; i < count && turn(found + count - 1) == 0.0 && isFarther(p, getPosition(group, (found + count - 1) % count), getPosition(group, found)); i++)
+					found = (found + count - 1) % count;
+
+				tangent._vertex = found;
+				return true;
+			}
+		}
+
+		// Small groups, and any the search could not settle, are checked point by point
+		bool found = false;
+		for (size_t i = 0; i < count; i++)
+		{
+			uint32_t c = getPosition(group, i);
+			if (isSamePoint(p, c))
+				continue;
+			if (found == false || isBetterNext(p, getPosition(group, tangent._vertex), c))
+			{
+				tangent._vertex = i;
+				found = true;
+			}
+		}
+		return found;
+	}
+
+	// True when c is a better next hull point after p than best
+	bool isBetterNext(uint32_t p, uint32_t best, uint32_t c) const
+	{
+		double turn = MonotoneChainHull::cross(_x[p], _y[p], _x[best], _y[best], _x[c], _y[c]);
+		return turn < 0.0 || (turn == 0.0 && isFarther(p, c, best));
+	}
+	// True when a is farther from p than b
+	bool isFarther(uint32_t p, uint32_t a, uint32_t b) const
+	{
+		float adx = _x[a] - _x[p], ady = _y[a] - _y[p];
+		float bdx = _x[b] - _x[p], bdy = _y[b] - _y[p];
+		return adx * adx + ady * ady > bdx * bdx + bdy * bdy;
+	}
+	bool isSamePoint(uint32_t a, uint32_t b) const
+	{
+		return _x[a] == _x[b] && _y[a] == _y[b];
+	}
+	double getTurn(uint32_t p, size_t group, size_t from, size_t to) const
+	{
+		uint32_t a = getPosition(group, from);
+		uint32_t b = getPosition(group, to);
+		return MonotoneChainHull::cross(_x[p], _y[p], _x[a], _y[a], _x[b], _y[b]);
+	}
+
+	size_t getVertexCount(size_t group) const
+	{
+		return _groupStart[group + 1] - _groupStart[group];
+	}
+	// Position in the sorted points
+	uint32_t getPosition(size_t group, size_t vertex) const
+	{
+		return _groupHulls[_groupStart[group] + vertex];
+	}
+	uint32_t getPosition(const Vertex& vertex) const
+	{
+		return getPosition(vertex._group, vertex._vertex);
+	}
+
+private:
+	MonotoneChainHull _sorter;
+	const float* _x = nullptr;
+	const float* _y = nullptr;
+
+	std::vector<uint32_t> _groupHulls; // Group hulls one after the other, as sorted positions
+	std::vector<size_t> _groupStart;
+	std::vector<uint32_t> _result;
+};
@@ -0,0 +1,279 @@
+// DynamicHull.h
+// Nathan Damon
+// 2026-10-16
+// Convex hull that points can be added to one at a time
+//
+// The hull is kept as its upper and lower chains, each an ordered map from
+// x to the hull point at that x. The lower chain is stored with y flipped
+// so both chains are handled as upper chains. Adding a point finds its
+// neighbours on each chain in O(log h) for h hull points. A point that is
+// not above either chain is inside the hull and is rejected there,
+// otherwise it is added and the neighbours it hides are removed, which is
+// O(log h) per point over a run of insertions.
+//
+// Removing points needs the points inside the hull as well, so it is only
+// possible with setKeepPoints(true). Removing a hull point fills the gap
+// between its neighbours from the kept points in that x range.
+//
+// The map nodes come from a pool owned by the hull. Removed and cleared
+// nodes go back to the pool, so clearing and adding the same number of
+// points again does not allocate.
+
+#pragma once
+#include "MonotoneChainHull.h"
+#include <map>
+#include <memory_resource>
+#include <limits>
+
+class DynamicHull : public HullEngine
+{
+public:
+	DynamicHull() {}
+	~DynamicHull() {}
+
+	std::string getName() const override
+	{
+		return "DynamicHull";
+	}
+
+	// Adds every point one at a time, mostly for comparing against the other engines
+	bool computeHull(HullPoints& points, std::vector<HullEdge>& edges, std::vector<HullEdge>* debugEdges = nullptr) override
+	{
+		(void)debugEdges;
+		HullProfiler::Scope runScope(_profiler, "DynamicHull");
+		clear();
+		for (size_t i = 0; i < points.size(); i++)
+			insert(points._x[i], points._y[i], uint32_t(i));
+		getHull(points, edges);
+		return true;
+	}
+
+	void clear()
+	{
+		_upper._vertices.clear();
+		_lower._vertices.clear();
+		_keptPoints.clear();
+	}
+
+	// Keeping every point that is added lets points be removed later
+	void setKeepPoints(bool keepPoints)
+	{
+		_keepPoints = keepPoints;
+		if (_keepPoints == false)
+			_keptPoints.clear();
+	}
+	bool isKeepingPoints() const
+	{
+		return _keepPoints;
+	}
+
+	// Returns true when the point is on the hull after adding it, false when it was rejected as inside
+	bool insert(float x, float y, uint32_t index)
+	{
+		if (_keepPoints)
+			_keptPoints.insert({ x, { y, index } });
+
+		bool onUpper = _upper.insert(x, y, index);
+		bool onLower = _lower.insert(x, -y, index);
+		return onUpper || onLower;
+	}
+
+	// Returns false when the point was not found or points are not being kept
+	bool erase(float x, float y, uint32_t index)
+	{
+		if (_keepPoints == false)
+			return false;
+
+		auto range = _keptPoints.equal_range(x);
+		auto found = range.second;
+		for (auto it = range.first; it != range.second; it++)
+		{
+			if (it->second._index == index && it->second._y == y)
+				found = it;
+		}
+		if (found == range.second)
+			return false;
+		_keptPoints.erase(found);
+
+		eraseFromChain(_upper, x, index, 1.0f);
+		eraseFromChain(_lower, x, index, -1.0f);
+		return true;
+	}
+
+	// True when the point is inside or on the hull
+	bool contains(float x, float y) const
+	{
+		return _upper.isEmpty() == false && _upper.isAbove(x, y) == false && _lower.isAbove(x, -y) == false;
+	}
+
+	// Sets the on-hull bits, puts the hull in getHullOrder and adds the hull edges in counter clockwise order
+	void getHull(HullPoints& points, std::vector<HullEdge>& edges)
+	{
+		points.clearOnHull();
+		_hullOrder.clear();
+
+		// Lower chain left to right, then the upper chain right to left
+		for (auto& vertex : _lower._vertices)
+			_hullOrder.push_back(vertex.second._index);
+		for (auto it = _upper._vertices.rbegin(); it != _upper._vertices.rend(); it++)
+		{
+			uint32_t index = it->second._index;
+			bool isEnd = it == _upper._vertices.rbegin() || std::next(it) == _upper._vertices.rend();
+			if (isEnd && (index == _hullOrder.back() || index == _hullOrder.front() || isSamePoint(points, index, _hullOrder.back()) || isSamePoint(points, index, _hullOrder.front())))
+				continue;
+			_hullOrder.push_back(index);
+		}
+		addHullEdges(points, edges);
+	}
+
+	size_t getKeptPointCount() const
+	{
+		return _keptPoints.size();
+	}
+
+private:
+	struct Vertex
+	{
+		float _y;
+		uint32_t _index;
+	};
+
+	// Upper hull from left to right, one point for each x
+	class Chain
+	{
+	public:
+		Chain(std::pmr::memory_resource* nodes) : _vertices(nodes) {}
+
+		bool isEmpty() const
+		{
+			return _vertices.empty();
+		}
+
+		// True when the point is strictly above the chain or outside of its x range
+		bool isAbove(float x, float y) const
+		{
+			if (_vertices.empty())
+				return true;
+
+			auto right = _vertices.lower_bound(x);
+			if (right == _vertices.end())
+				return true;
+			if (right->first == x)
+				return y > right->second._y;
+			if (right == _vertices.begin())
+				return true;
+
+			auto left = std::prev(right);
+			return MonotoneChainHull::cross(left->first, left->second._y, right->first, right->second._y, x, y) > 0.0;
+		}
+
+		// Returns false when the point is not above the chain
+		bool insert(float x, float y, uint32_t index)
+		{
+			if (isAbove(x, y) == false)
+				return false;
+
+			auto point = _vertices.insert_or_assign(x, Vertex{ y, index }).first;
+
+			// Neighbours that no longer turn clockwise are below the new point's edges
+			while (point != _vertices.begin() && std::prev(point) != _vertices.begin())
+			{
+				auto left = std::prev(point);
+				auto leftOfLeft = std::prev(left);
+				if (MonotoneChainHull::cross(leftOfLeft->first, leftOfLeft->second._y, left->first, left->second._y, x, y) < 0.0)
+					break;
+				_vertices.erase(left);
+			}
+			while (std::next(point) != _vertices.end() && std::next(std::next(point)) != _vertices.end())
+			{
+				auto right = std::next(point);
+				auto rightOfRight = std::next(right);
+				if (MonotoneChainHull::cross(x, y, right->first, right->second._y, rightOfRight->first, rightOfRight->second._y) < 0.0)
+					break;
+				_vertices.erase(right);
+			}
+			return true;
+		}
+
+	public:
+		std::pmr::map<float, Vertex> _vertices;
+	};
+
+	// All of the map nodes are the same size, so freed nodes are kept on a list and handed
+	// out again. New nodes are cut from blocks that grow in size, which are only given
+	// back when the hull is destroyed
+	class NodePool : public std::pmr::memory_resource
+	{
+	private:
+		struct FreeNode
+		{
+			FreeNode* _next;
+		};
+
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			if (bytes == _nodeSize && _freeNodes)
+			{
+				FreeNode* node = _freeNodes;
+				_freeNodes = node->_next;
+				return node;
+			}
+			return _blocks.allocate(std::max(bytes, sizeof(FreeNode)), std::max(alignment, alignof(FreeNode)));
+		}
+		void do_deallocate(void* memory, size_t bytes, size_t alignment) override
+		{
+			(void)alignment;
+			// Only the first size seen is reused, anything else stays in the blocks
+			if (_nodeSize == 0)
+				_nodeSize = bytes;
+			if (bytes != _nodeSize)
+				return;
+			FreeNode* node = static_cast<FreeNode*>(memory);
+			node->_next = _freeNodes;
+			_freeNodes = node;
+		}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+		{
+			return this == &other;
+		}
+
+	private:
+		std::pmr::monotonic_buffer_resource _blocks;
+		FreeNode* _freeNodes = nullptr;
+		size_t _nodeSize = 0;
+	};
+
+	// The neighbours of a removed chain point stay on the hull, so only the kept
+	// points between them can become part of the chain
+	void eraseFromChain(Chain& chain, float x, uint32_t index, float sign)
+	{
+		auto point = chain._vertices.find(x);
+		if (point == chain._vertices.end() || point->second._index != index)
+			return;
+
+		auto from = _keptPoints.begin();
+		auto to = _keptPoints.end();
+		if (point != chain._vertices.begin())
+			from = _keptPoints.lower_bound(std::prev(point)->first);
+		if (std::next(point) != chain._vertices.end())
+			to = _keptPoints.upper_bound(std::next(point)->first);
+		chain._vertices.erase(point);
+
+		for (auto it = from; it != to; it++)
+			chain.insert(it->first, it->second._y * sign, it->second._index);
+	}
+
+	static bool isSamePoint(const HullPoints& points, uint32_t a, uint32_t b)
+	{
+		return points._x[a] == points._x[b] && points._y[a] == points._y[b];
+	}
+
+private:
+	NodePool _nodePool; // Before the maps, which use it
+
+	Chain _upper{ &_nodePool };
+	Chain _lower{ &_nodePool }; // y is flipped
+
+	bool _keepPoints = false;
+	std::pmr::multimap<float, Vertex> _keptPoints{ &_nodePool }; // Every point added, by x
+};
@@ -0,0 +1,112 @@
+// HullEngine.h
+// Nathan Damon
+// 2026-10-16
+// Common interface for the convex hull engines
+//
+// Every engine takes the same structure-of-arrays points, sets the on-hull
+// bit of each hull point and adds the hull edges as point index pairs, so
+// QuickHullSim and the benchmark can swap between them. The hull points are
+// also kept in counter clockwise order for HullPolygon and anything else
+// that needs the hull as a polygon.
+//
+// The interface is a template over the coordinate type of the points in
+// the same way as BasicHullPoints. HullEngine is the float version every
+// engine takes, QuickHullSoA also has double and int32_t versions.
+
+#pragma once
+#include "HullPoints.h"
+#include "SpscQueue.h"
+#include "HullProfiler.h"
+#include <string>
+
+// A line between two points, given as indices into HullPoints
+struct HullEdge
+{
+	uint32_t _a;
+	uint32_t _b;
+};
+
+// Takes the vertices that are not corners out of a hull in counter clockwise order, in place, and
+// returns how many are left. isFlatTurn(a, b, c) is true when a, b, c do not turn counter clockwise.
+// The first vertex has to be a corner: it is checked against again at the end to close the hull, but
+// only ever as the last of a turn, so it is never taken out itself
+template <typename Vertex, typename IsFlatTurn>
+size_t removeFlatHullVertices(Vertex* hull, size_t count, IsFlatTurn isFlatTurn)
+{
+	if (count < 3)
+		return count;
+
+	size_t kept = 0;
+	for (size_t i = 0; i <= count; i++)
+	{
+		const Vertex vertex = hull[i % count];
+		size_t keep = i == count ? 2 : 1;
+		while (kept > keep && isFlatTurn(hull[kept - 2], hull[kept - 1], vertex))
+			kept--;
+		if (i == count)
+			break;
+		hull[kept++] = vertex;
+	}
+	return kept;
+}
+
+template <typename Scalar>
+class BasicHullEngine
+{
+public:
+	using Points = BasicHullPoints<Scalar>;
+
+public:
+	virtual ~BasicHullEngine() {}
+
+	virtual std::string getName() const = 0;
+
+	// Returns true on complete
+	// Final hull edges are added to edges and the on-hull bits of points are set.
+	// Engines that have lines worth showing while debugging add them to debugEdges when given
+	virtual bool computeHull(Points& points, std::vector<HullEdge>& edges, std::vector<HullEdge>* debugEdges = nullptr) = 0;
+
+	// Point indices of the hull from the last run in counter clockwise order
+	const std::vector<uint32_t>& getHullOrder() const
+	{
+		return _hullOrder;
+	}
+
+	// Hull edges are also pushed to queue as soon as an engine knows they are final, when one is
+	// set, so another thread can show a run as it goes. Only engines that finish edges part way
+	// through push any, the others find the whole hull at once. Edges that do not fit in the
+	// queue are left out
+	void setProgressQueue(SpscQueue<HullEdge>* queue)
+	{
+		_progressQueue = queue;
+	}
+	// Engines time their phases into profiler when one is set
+	void setProfiler(HullProfiler* profiler)
+	{
+		_profiler = profiler;
+	}
+
+protected:
+	// Sets the on-hull bits and adds the edges of _hullOrder
+	void addHullEdges(Points& points, std::vector<HullEdge>& edges) const
+	{
+		for (size_t i = 0; i < _hullOrder.size(); i++)
+		{
+			points.setAsOnHull(_hullOrder[i]);
+			if (_hullOrder.size() > 1)
+				edges.push_back({ _hullOrder[i], _hullOrder[(i + 1) % _hullOrder.size()] });
+		}
+	}
+	void addProgressEdge(uint32_t a, uint32_t b)
+	{
+		if (_progressQueue)
+			_progressQueue->tryPush({ a, b });
+	}
+
+protected:
+	std::vector<uint32_t> _hullOrder;
+	SpscQueue<HullEdge>* _progressQueue = nullptr;
+	HullProfiler* _profiler = nullptr;
+};
+
+using HullEngine = BasicHullEngine<float>;
@@ -0,0 +1,373 @@
+// HullKernels.h
+// Nathan Damon
+// 2026-10-16
+// Vectorized point kernels for the hull engines
+//
+// Each kernel has a scalar version and, on x86-64, SSE2 and AVX2 versions.
+// The best one the CPU supports is picked the first time the kernels are
+// used. All versions compute the side values the same way (no fused
+// multiply-add), so they all give the same results. Side values too close
+// to zero to trust their sign are checked again with the exact
+// orientation test from HullPredicates.
+//
+// Double and int32_t points, for the versions of QuickHullSoA that take
+// them, are split one at a time by the scalar version with the exact test
+// of their ScalarPredicates.
+
+#pragma once
+#include "HullPredicates.h"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define HULL_KERNELS_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// Visual Studio lets any function use the intrinsics, GCC and Clang have to be told per function
+#if defined(HULL_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define HULL_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define HULL_TARGET_AVX2
+#endif
+
+// Line from A to B for double and int32_t points
+template <typename Scalar>
+struct BasicHullLine
+{
+	using Side = double;
+
+	BasicHullLine(Scalar ax = 0, Scalar ay = 0, Scalar bx = 0, Scalar by = 0) : _ax(ax), _ay(ay), _bx(bx), _by(by) {}
+
+	// Greater than zero when the point is above the line, the sign is exact and the size is rounded
+	Side side(Scalar px, Scalar py) const
+	{
+		return ScalarPredicates<Scalar>::orientation(_bx, _by, _ax, _ay, px, py);
+	}
+
+	Scalar _ax;
+	Scalar _ay;
+	Scalar _bx;
+	Scalar _by;
+};
+
+// Line from A to B, stored the way the side test uses it
+template <>
+struct BasicHullLine<float>
+{
+	using Side = float;
+
+	BasicHullLine(float ax = 0.0f, float ay = 0.0f, float bx = 0.0f, float by = 0.0f) : _ax(ax), _ay(ay), _bx(bx), _by(by), _dx(bx - ax), _dy(by - ay) {}
+
+	// Greater than zero when the point is above the line (the side the hull is being built on)
+	// This is the signed cross product, the distance to the line scaled by the length of A-B.
+	// The sign is exact, the size is rounded
+	float side(float px, float py) const
+	{
+		float left = (px - _ax) * _dy;
+		float right = (py - _ay) * _dx;
+		float side = left - right;
+		if (fabsf(side) > HullPredicates::floatErrorBound * (fabsf(left) + fabsf(right)))
+			return side;
+		return exactSide(px, py);
+	}
+	// For sides the rounded value could have the wrong sign for
+	float exactSide(float px, float py) const
+	{
+		return HullPredicates::toFloat(HullPredicates::orientation(_bx, _by, _ax, _ay, px, py));
+	}
+
+	float _ax;
+	float _ay;
+	float _bx;
+	float _by;
+	float _dx;
+	float _dy;
+};
+
+using HullLine = BasicHullLine<float>;
+
+class HullKernels
+{
+public:
+	// Positions are relative to the start of the block that was split
+	struct SplitResult
+	{
+		size_t _firstCount = 0;
+		size_t _secondCount = 0;
+		size_t _firstFarthest = 0;
+		size_t _secondFarthest = 0;
+	};
+
+	// Reorders the block so the points above the first line come first, followed by
+	// the points above the second line. Points above neither line are dropped and
+	// their slots are overwritten. The farthest point above each line is found in
+	// the same pass, so the next level does not need to look for it
+	using SplitFunction = SplitResult(*)(float* x, float* y, uint32_t* index, size_t count, const HullLine& first, const HullLine& second);
+
+public:
+	static SplitResult splitAboveLines(float* x, float* y, uint32_t* index, size_t count, const HullLine& first, const HullLine& second)
+	{
+		return get()._split(x, y, index, count, first, second);
+	}
+
+	// The scalar split for the other coordinate types
+	template <typename Scalar>
+	static SplitResult splitAboveLines(Scalar* x, Scalar* y, uint32_t* index, size_t count, const BasicHullLine<Scalar>& first, const BasicHullLine<Scalar>& second)
+	{
+		SplitState<typename BasicHullLine<Scalar>::Side> state;
+		splitTail(x, y, index, 0, count, first, second, state);
+		return finishSplit(state);
+	}
+
+	static const char* getName()
+	{
+		return get()._name;
+	}
+
+private:
+	struct Table
+	{
+		SplitFunction _split;
+		const char* _name;
+	};
+
+	static const Table& get()
+	{
+		static const Table table = pickTable();
+		return table;
+	}
+	static Table pickTable()
+	{
+#if defined(HULL_KERNELS_X86)
+		if (cpuSupportsAVX2())
+			return { splitAboveLinesAVX2, "AVX2" };
+		return { splitAboveLinesSSE2, "SSE2" };
+#else
+		return { splitAboveLinesScalar, "Scalar" };
+#endif
+	}
+
+	// Tracks where the two groups end while a block is being split
+	template <typename Side>
+	struct SplitState
+	{
+		size_t _firstEnd = 0;
+		size_t _secondEnd = 0;
+		Side _firstFarthestSide = 0;
+		Side _secondFarthestSide = 0;
+		SplitResult _result;
+	};
+
+	// Writes are only made at or before the point being read, so the points
+	// that have not been looked at yet are never overwritten
+	template <typename Scalar, typename Side>
+	static void placeFirst(Scalar* x, Scalar* y, uint32_t* index, size_t i, Side side, SplitState<Side>& state)
+	{
+		Scalar px = x[i];
+		Scalar py = y[i];
+		uint32_t pIndex = index[i];
+
+		// Make room by moving the first point of the second group to its end
+		if (state._firstEnd != state._secondEnd)
+		{
+			x[state._secondEnd] = x[state._firstEnd];
+			y[state._secondEnd] = y[state._firstEnd];
+			index[state._secondEnd] = index[state._firstEnd];
+			if (state._result._secondFarthest == state._firstEnd)
+				state._result._secondFarthest = state._secondEnd;
+		}
+		x[state._firstEnd] = px;
+		y[state._firstEnd] = py;
+		index[state._firstEnd] = pIndex;
+
+		if (side > state._firstFarthestSide)
+		{
+			state._firstFarthestSide = side;
+			state._result._firstFarthest = state._firstEnd;
+		}
+		state._firstEnd++;
+		state._secondEnd++;
+	}
+	template <typename Scalar, typename Side>
+	static void placeSecond(Scalar* x, Scalar* y, uint32_t* index, size_t i, Side side, SplitState<Side>& state)
+	{
+		x[state._secondEnd] = x[i];
+		y[state._secondEnd] = y[i];
+		index[state._secondEnd] = index[i];
+
+		if (side > state._secondFarthestSide)
+		{
+			state._secondFarthestSide = side;
+			state._result._secondFarthest = state._secondEnd;
+		}
+		state._secondEnd++;
+	}
+	template <typename Side>
+	static SplitResult finishSplit(SplitState<Side>& state)
+	{
+		state._result._firstCount = state._firstEnd;
+		state._result._secondCount = state._secondEnd - state._firstEnd;
+		return state._result;
+	}
+	template <typename Scalar>
+	static void splitTail(Scalar* x, Scalar* y, uint32_t* index, size_t start, size_t count, const BasicHullLine<Scalar>& first, const BasicHullLine<Scalar>& second,
+		SplitState<typename BasicHullLine<Scalar>::Side>& state)
+	{
+		for (size_t i = start; i < count; i++)
+		{
+			auto firstSide = first.side(x[i], y[i]);
+			if (firstSide > 0)
+			{
+				placeFirst(x, y, index, i, firstSide, state);
+				continue;
+			}
+			auto secondSide = second.side(x[i], y[i]);
+			if (secondSide > 0)
+				placeSecond(x, y, index, i, secondSide, state);
+		}
+	}
+
+	// Lanes of a block that are above each line, or too close to it to tell without the exact test
+	struct LaneMasks
+	{
+		int _first = 0;
+		int _second = 0;
+		int _firstUnsure = 0;
+		int _secondUnsure = 0;
+	};
+	static void placeLanes(float* x, float* y, uint32_t* index, size_t i, int laneCount, const LaneMasks& masks,
+		const float* firstSides, const float* secondSides, const HullLine& first, const HullLine& second, SplitState<float>& state)
+	{
+		for (int lane = 0; lane < laneCount; lane++)
+		{
+			int bit = 1 << lane;
+			float firstSide = firstSides[lane];
+			if (masks._firstUnsure & bit)
+				firstSide = first.exactSide(x[i + lane], y[i + lane]);
+			if ((masks._first & bit) || ((masks._firstUnsure & bit) && firstSide > 0.0f))
+			{
+				placeFirst(x, y, index, i + lane, firstSide, state);
+				continue;
+			}
+
+			float secondSide = secondSides[lane];
+			if (masks._secondUnsure & bit)
+				secondSide = second.exactSide(x[i + lane], y[i + lane]);
+			if ((masks._second & bit) || ((masks._secondUnsure & bit) && secondSide > 0.0f))
+				placeSecond(x, y, index, i + lane, secondSide, state);
+		}
+	}
+
+	static SplitResult splitAboveLinesScalar(float* x, float* y, uint32_t* index, size_t count, const HullLine& first, const HullLine& second)
+	{
+		SplitState<float> state;
+		splitTail(x, y, index, 0, count, first, second, state);
+		return finishSplit(state);
+	}
+
+#if defined(HULL_KERNELS_X86)
+	static bool cpuSupportsAVX2()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+		__cpuid(info, 1);
+		bool osSavesYMM = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+		__cpuidex(info, 7, 0);
+		return osSavesYMM && (info[1] & (1 << 5));
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+	static SplitResult splitAboveLinesSSE2(float* x, float* y, uint32_t* index, size_t count, const HullLine& first, const HullLine& second)
+	{
+		SplitState<float> state;
+		const __m128 signBit = _mm_set1_ps(-0.0f);
+		const __m128 errorBound = _mm_set1_ps(HullPredicates::floatErrorBound);
+		const __m128 ax1 = _mm_set1_ps(first._ax), ay1 = _mm_set1_ps(first._ay);
+		const __m128 dx1 = _mm_set1_ps(first._dx), dy1 = _mm_set1_ps(first._dy);
+		const __m128 ax2 = _mm_set1_ps(second._ax), ay2 = _mm_set1_ps(second._ay);
+		const __m128 dx2 = _mm_set1_ps(second._dx), dy2 = _mm_set1_ps(second._dy);
+		alignas(16) float firstSides[4];
+		alignas(16) float secondSides[4];
+
+		size_t i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 px = _mm_loadu_ps(x + i);
+			__m128 py = _mm_loadu_ps(y + i);
+			__m128 left1 = _mm_mul_ps(_mm_sub_ps(px, ax1), dy1);
+			__m128 right1 = _mm_mul_ps(_mm_sub_ps(py, ay1), dx1);
+			__m128 left2 = _mm_mul_ps(_mm_sub_ps(px, ax2), dy2);
+			__m128 right2 = _mm_mul_ps(_mm_sub_ps(py, ay2), dx2);
+			__m128 side1 = _mm_sub_ps(left1, right1);
+			__m128 side2 = _mm_sub_ps(left2, right2);
+			__m128 bound1 = _mm_mul_ps(errorBound, _mm_add_ps(_mm_andnot_ps(signBit, left1), _mm_andnot_ps(signBit, right1)));
+			__m128 bound2 = _mm_mul_ps(errorBound, _mm_add_ps(_mm_andnot_ps(signBit, left2), _mm_andnot_ps(signBit, right2)));
+
+			LaneMasks masks;
+			masks._first = _mm_movemask_ps(_mm_cmpgt_ps(side1, bound1));
+			masks._second = _mm_movemask_ps(_mm_cmpgt_ps(side2, bound2));
+			masks._firstUnsure = _mm_movemask_ps(_mm_cmple_ps(_mm_andnot_ps(signBit, side1), bound1));
+			masks._secondUnsure = _mm_movemask_ps(_mm_cmple_ps(_mm_andnot_ps(signBit, side2), bound2));
+			if ((masks._first | masks._second | masks._firstUnsure | masks._secondUnsure) == 0)
+				continue; // Most blocks are inside the triangle
+
+			_mm_store_ps(firstSides, side1);
+			_mm_store_ps(secondSides, side2);
+			placeLanes(x, y, index, i, 4, masks, firstSides, secondSides, first, second, state);
+		}
+		splitTail(x, y, index, i, count, first, second, state);
+		return finishSplit(state);
+	}
+
+	HULL_TARGET_AVX2 static SplitResult splitAboveLinesAVX2(float* x, float* y, uint32_t* index, size_t count, const HullLine& first, const HullLine& second)
+	{
+		SplitState<float> state;
+		const __m256 signBit = _mm256_set1_ps(-0.0f);
+		const __m256 errorBound = _mm256_set1_ps(HullPredicates::floatErrorBound);
+		const __m256 ax1 = _mm256_set1_ps(first._ax), ay1 = _mm256_set1_ps(first._ay);
+		const __m256 dx1 = _mm256_set1_ps(first._dx), dy1 = _mm256_set1_ps(first._dy);
+		const __m256 ax2 = _mm256_set1_ps(second._ax), ay2 = _mm256_set1_ps(second._ay);
+		const __m256 dx2 = _mm256_set1_ps(second._dx), dy2 = _mm256_set1_ps(second._dy);
+		alignas(32) float firstSides[8];
+		alignas(32) float secondSides[8];
+
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 px = _mm256_loadu_ps(x + i);
+			__m256 py = _mm256_loadu_ps(y + i);
+			__m256 left1 = _mm256_mul_ps(_mm256_sub_ps(px, ax1), dy1);
+			__m256 right1 = _mm256_mul_ps(_mm256_sub_ps(py, ay1), dx1);
+			__m256 left2 = _mm256_mul_ps(_mm256_sub_ps(px, ax2), dy2);
+			__m256 right2 = _mm256_mul_ps(_mm256_sub_ps(py, ay2), dx2);
+			__m256 side1 = _mm256_sub_ps(left1, right1);
+			__m256 side2 = _mm256_sub_ps(left2, right2);
+			__m256 bound1 = _mm256_mul_ps(errorBound, _mm256_add_ps(_mm256_andnot_ps(signBit, left1), _mm256_andnot_ps(signBit, right1)));
+			__m256 bound2 = _mm256_mul_ps(errorBound, _mm256_add_ps(_mm256_andnot_ps(signBit, left2), _mm256_andnot_ps(signBit, right2)));
+
+			LaneMasks masks;
+			masks._first = _mm256_movemask_ps(_mm256_cmp_ps(side1, bound1, _CMP_GT_OQ));
+			masks._second = _mm256_movemask_ps(_mm256_cmp_ps(side2, bound2, _CMP_GT_OQ));
+			masks._firstUnsure = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_andnot_ps(signBit, side1), bound1, _CMP_LE_OQ));
+			masks._secondUnsure = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_andnot_ps(signBit, side2), bound2, _CMP_LE_OQ));
+			if ((masks._first | masks._second | masks._firstUnsure | masks._secondUnsure) == 0)
+				continue; // Most blocks are inside the triangle
+
+			_mm256_store_ps(firstSides, side1);
+			_mm256_store_ps(secondSides, side2);
+			placeLanes(x, y, index, i, 8, masks, firstSides, secondSides, first, second, state);
+		}
+		splitTail(x, y, index, i, count, first, second, state);
+		return finishSplit(state);
+	}
+#endif
+};
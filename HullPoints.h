@@ -0,0 +1,70 @@
+// HullPoints.h
+// Nathan Damon
+// 2026-10-16
+// Structure-of-arrays point storage for the hull engines
+//
+// The x and y coordinates are kept in their own contiguous arrays so the
+// hull passes only touch the data they need, and which points are on the
+// hull is kept as one bit per point instead of being a color.
+//
+// The coordinate type is a template parameter for BasicQuickHullSoA, which
+// takes double and int32_t points as well. HullPoints is the float version
+// every other engine uses.
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+template <typename Scalar>
+class BasicHullPoints
+{
+public:
+	BasicHullPoints(size_t count = 0)
+	{
+		resize(count);
+	}
+	~BasicHullPoints() {}
+
+	void resize(size_t count)
+	{
+		_x.resize(count);
+		_y.resize(count);
+		_onHullBits.assign((count + 63) / 64, 0);
+	}
+	size_t size() const
+	{
+		return _x.size();
+	}
+
+	void setPoint(size_t index, Scalar x, Scalar y)
+	{
+		_x[index] = x;
+		_y[index] = y;
+	}
+
+	void setAsOnHull(size_t index)
+	{
+		_onHullBits[index >> 6] |= uint64_t(1) << (index & 63);
+	}
+	void clearAsOnHull(size_t index)
+	{
+		_onHullBits[index >> 6] &= ~(uint64_t(1) << (index & 63));
+	}
+	bool isOnHull(size_t index) const
+	{
+		return (_onHullBits[index >> 6] >> (index & 63)) & 1;
+	}
+	void clearOnHull()
+	{
+		for (auto& bits : _onHullBits)
+			bits = 0;
+	}
+
+public:
+	std::vector<Scalar> _x;
+	std::vector<Scalar> _y;
+	std::vector<uint64_t> _onHullBits;
+};
+
+using HullPoints = BasicHullPoints<float>;
@@ -0,0 +1,61 @@
+// HullPoints3D.h
+// Nathan Damon
+// 2026-10-16
+// Structure-of-arrays point storage for QuickHull3D
+//
+// The same layout as HullPoints with a third coordinate array, so the 3D
+// hull passes read only the coordinates and the on-hull bits.
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class HullPoints3D
+{
+public:
+	HullPoints3D(size_t count = 0)
+	{
+		resize(count);
+	}
+	~HullPoints3D() {}
+
+	void resize(size_t count)
+	{
+		_x.resize(count);
+		_y.resize(count);
+		_z.resize(count);
+		_onHullBits.assign((count + 63) / 64, 0);
+	}
+	size_t size() const
+	{
+		return _x.size();
+	}
+
+	void setPoint(size_t index, float x, float y, float z)
+	{
+		_x[index] = x;
+		_y[index] = y;
+		_z[index] = z;
+	}
+
+	void setAsOnHull(size_t index)
+	{
+		_onHullBits[index >> 6] |= uint64_t(1) << (index & 63);
+	}
+	bool isOnHull(size_t index) const
+	{
+		return (_onHullBits[index >> 6] >> (index & 63)) & 1;
+	}
+	void clearOnHull()
+	{
+		for (auto& bits : _onHullBits)
+			bits = 0;
+	}
+
+public:
+	std::vector<float> _x;
+	std::vector<float> _y;
+	std::vector<float> _z;
+	std::vector<uint64_t> _onHullBits;
+};
@@ -0,0 +1,92 @@
+// HullPolygon.h
+// Nathan Damon
+// 2026-10-16
+// Queries on a hull given as point indices in counter clockwise order
+//
+// Works on the order from HullEngine::getHullOrder (or anything else in the
+// same form), so nothing has to be sorted or rebuilt between a hull run and
+// a query. The sums are done in double and relative to the first hull point
+// so large coordinates do not lose the small differences between them.
+
+#pragma once
+#include "HullPoints.h"
+#include "HullPredicates.h"
+#include <cmath>
+
+class HullPolygon
+{
+public:
+	// Positive for a counter clockwise hull, zero with fewer than three points
+	static double area(const HullPoints& points, const std::vector<uint32_t>& hull)
+	{
+		if (hull.size() < 3)
+			return 0.0;
+
+		double x0 = points._x[hull[0]];
+		double y0 = points._y[hull[0]];
+		double twiceArea = 0.0;
+		for (size_t i = 1; i + 1 < hull.size(); i++)
+		{
+			double ax = points._x[hull[i]] - x0, ay = points._y[hull[i]] - y0;
+			double bx = points._x[hull[i + 1]] - x0, by = points._y[hull[i + 1]] - y0;
+			twiceArea += ax * by - ay * bx;
+		}
+		return twiceArea * 0.5;
+	}
+
+	// Two points give twice their distance, the way there and back
+	static double perimeter(const HullPoints& points, const std::vector<uint32_t>& hull)
+	{
+		double length = 0.0;
+		for (size_t i = 0; hull.size() > 1 && i < hull.size(); i++)
+		{
+			uint32_t a = hull[i];
+			uint32_t b = hull[(i + 1) % hull.size()];
+			length += std::hypot(double(points._x[b]) - double(points._x[a]), double(points._y[b]) - double(points._y[a]));
+		}
+		return length;
+	}
+
+	// True when the point is inside or on the hull, O(log h) for h hull points
+	// The first hull point splits the hull into a fan of triangles, the one the point
+	// could be in is found with a binary search and then the point is checked against
+	// its outer edge. All of the tests are exact
+	static bool contains(const HullPoints& points, const std::vector<uint32_t>& hull, float x, float y)
+	{
+		size_t count = hull.size();
+		if (count == 0)
+			return false;
+		if (count == 1)
+			return points._x[hull[0]] == x && points._y[hull[0]] == y;
+		if (count == 2)
+			return isOnSegment(points, hull[0], hull[1], x, y);
+
+		if (orientation(points, hull[0], hull[1], x, y) < 0.0 || orientation(points, hull[0], hull[count - 1], x, y) > 0.0)
+			return false;
+
+		size_t low = 1;
+		size_t high = count - 1;
+		while (high - low > 1)
+		{
+			size_t middle = (low + high) / 2;
+			if (orientation(points, hull[0], hull[middle], x, y) >= 0.0)
+				low = middle;
+			else
+				high = middle;
+		}
+		return orientation(points, hull[low], hull[high], x, y) >= 0.0;
+	}
+
+private:
+	static double orientation(const HullPoints& points, uint32_t a, uint32_t b, float x, float y)
+	{
+		return HullPredicates::orientation(points._x[a], points._y[a], points._x[b], points._y[b], x, y);
+	}
+	static bool isOnSegment(const HullPoints& points, uint32_t a, uint32_t b, float x, float y)
+	{
+		if (orientation(points, a, b, x, y) != 0.0)
+			return false;
+		return x >= std::fmin(points._x[a], points._x[b]) && x <= std::fmax(points._x[a], points._x[b]) &&
+			y >= std::fmin(points._y[a], points._y[b]) && y <= std::fmax(points._y[a], points._y[b]);
+	}
+};
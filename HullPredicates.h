@@ -0,0 +1,318 @@
+// HullPredicates.h
+// Nathan Damon
+// 2026-10-16
+// Robust orientation test for the hull engines
+//
+// Which side of a line a point is on decides everything the hull engines
+// do, and with a million points some of them are close enough to a line
+// that the rounded cross product has the wrong sign. This follows
+// Shewchuk's adaptive predicates: the cross product is worked out in
+// double together with a bound on its rounding error, and only when the
+// result is within that bound of zero is it worked out again exactly
+// with floating point expansions. With float inputs the double result is
+// almost always enough and the exact path is rarely taken. Double inputs,
+// and int32_t ones which are exact as doubles, take the same test.
+//
+// The 3D test for QuickHull3D, which side of a plane through three points
+// a fourth one is on, is done the same way.
+
+#pragma once
+#include <cmath>
+#include <cfloat>
+#include <cstdint>
+
+class HullPredicates
+{
+public:
+	// Rounding error bounds of a cross product of differences, relative to the sum of
+	// the sizes of its two products (Shewchuk's ccwerrboundA)
+	static constexpr float floatErrorBound = (3.0f + 16.0f * FLT_EPSILON * 0.5f) * FLT_EPSILON * 0.5f;
+	static constexpr double doubleErrorBound = (3.0 + 16.0 * DBL_EPSILON * 0.5) * DBL_EPSILON * 0.5;
+	// The same for a 3 by 3 determinant of differences, relative to its permanent (Shewchuk's o3derrboundA)
+	static constexpr double double3DErrorBound = (7.0 + 56.0 * DBL_EPSILON * 0.5) * DBL_EPSILON * 0.5;
+
+	// Positive when A, B, C turn counter clockwise (C is left of A to B), negative when they
+	// turn clockwise and zero when they are in line. The sign is always exact, the size is
+	// twice the area of the triangle, rounded
+	static double orientation(double ax, double ay, double bx, double by, double cx, double cy)
+	{
+		double detLeft = (ax - cx) * (by - cy);
+		double detRight = (ay - cy) * (bx - cx);
+		double det = detLeft - detRight;
+
+		// Products of different signs can not cancel
+		double detSum;
+		if (detLeft > 0.0)
+		{
+			if (detRight <= 0.0)
+				return det;
+			detSum = detLeft + detRight;
+		}
+		else if (detLeft < 0.0)
+		{
+			if (detRight >= 0.0)
+				return det;
+			detSum = -detLeft - detRight;
+		}
+		else
+			return det;
+
+		if (std::fabs(det) >= doubleErrorBound * detSum)
+			return det;
+		return orientationExact(ax, ay, bx, by, cx, cy);
+	}
+
+	// The plane through A, B and C, set up once for testing many points against it. The
+	// normal and the filter's bound are worked out the same way orientation3D does, so the
+	// results are the same as calling it for each point
+	struct Plane3D
+	{
+		Plane3D() {}
+		Plane3D(float ax, float ay, float az, float bx, float by, float bz, float cx, float cy, float cz)
+			: _a{ ax, ay, az }, _b{ bx, by, bz }, _c{ cx, cy, cz }
+		{
+			double bax = double(bx) - double(ax), bay = double(by) - double(ay), baz = double(bz) - double(az);
+			double cax = double(cx) - double(ax), cay = double(cy) - double(ay), caz = double(cz) - double(az);
+
+			// The normal (B - A) x (C - A) and the sizes of the two products in each part of it
+			double baycaz = bay * caz, bazcay = baz * cay;
+			double bazcax = baz * cax, baxcaz = bax * caz;
+			double baxcay = bax * cay, baycax = bay * cax;
+			_normal[0] = baycaz - bazcay;
+			_normal[1] = bazcax - baxcaz;
+			_normal[2] = baxcay - baycax;
+			_permanent[0] = std::fabs(baycaz) + std::fabs(bazcay);
+			_permanent[1] = std::fabs(bazcax) + std::fabs(baxcaz);
+			_permanent[2] = std::fabs(baxcay) + std::fabs(baycax);
+		}
+
+		// Positive when D is on the side A, B, C turn counter clockwise seen from, negative
+		// on the other side and zero on the plane, see orientation3D
+		double orientation(float dx, float dy, float dz) const
+		{
+			double dax = double(dx) - double(_a[0]), day = double(dy) - double(_a[1]), daz = double(dz) - double(_a[2]);
+			double det = dax * _normal[0] + day * _normal[1] + daz * _normal[2];
+			double permanent = std::fabs(dax) * _permanent[0] + std::fabs(day) * _permanent[1] + std::fabs(daz) * _permanent[2];
+			double bound = double3DErrorBound * permanent;
+			if (det > bound || -det > bound)
+				return det;
+			return orientation3DExact(_a[0], _a[1], _a[2], _b[0], _b[1], _b[2], _c[0], _c[1], _c[2], dx, dy, dz);
+		}
+
+		float _a[3] = { 0.0f, 0.0f, 0.0f };
+		float _b[3] = { 0.0f, 0.0f, 0.0f };
+		float _c[3] = { 0.0f, 0.0f, 0.0f };
+		double _normal[3] = { 0.0, 0.0, 0.0 };
+		double _permanent[3] = { 0.0, 0.0, 0.0 };
+	};
+
+	// Positive when D is on the side of the plane through A, B and C that A, B, C turn counter
+	// clockwise seen from, negative on the other side and zero when all four are on one plane.
+	// The sign is always exact, the size is six times the volume of the tetrahedron
+	static double orientation3D(float ax, float ay, float az, float bx, float by, float bz,
+		float cx, float cy, float cz, float dx, float dy, float dz)
+	{
+		return Plane3D(ax, ay, az, bx, by, bz, cx, cy, cz).orientation(dx, dy, dz);
+	}
+
+	// Float of a result that keeps its sign, even when it is too small for a float
+	static float toFloat(double value)
+	{
+		float result = float(value);
+		if (result == 0.0f && value != 0.0)
+			return value > 0.0 ? FLT_MIN : -FLT_MIN;
+		return result;
+	}
+
+private:
+	// The cross product as an exact sum of doubles, returns its largest part
+	static double orientationExact(double ax, double ay, double bx, double by, double cx, double cy)
+	{
+		// Each difference is exact as the sum of two doubles
+		double acx[2], acy[2], bcx[2], bcy[2];
+		twoDiff(ax, cx, acx[1], acx[0]);
+		twoDiff(ay, cy, acy[1], acy[0]);
+		twoDiff(bx, cx, bcx[1], bcx[0]);
+		twoDiff(by, cy, bcy[1], bcy[0]);
+
+		// acx * bcy - acy * bcx, every product of the parts is exact as two doubles
+		double expansion[16];
+		int length = 0;
+		for (int i = 0; i < 2; i++)
+		{
+			for (int j = 0; j < 2; j++)
+			{
+				double product, error;
+				twoProduct(acx[i], bcy[j], product, error);
+				growExpansion(expansion, length, error);
+				growExpansion(expansion, length, product);
+				twoProduct(acy[i], bcx[j], product, error);
+				growExpansion(expansion, length, -error);
+				growExpansion(expansion, length, -product);
+			}
+		}
+
+		// The parts do not overlap and get larger, so the last one that is not zero has the sign
+		for (int i = length - 1; i >= 0; i--)
+		{
+			if (expansion[i] != 0.0)
+				return expansion[i];
+		}
+		return 0.0;
+	}
+
+	static double orientation3DExact(float ax, float ay, float az, float bx, float by, float bz,
+		float cx, float cy, float cz, float dx, float dy, float dz)
+	{
+		double ba[3][2], ca[3][2], da[3][2];
+		const float a[3] = { ax, ay, az }, b[3] = { bx, by, bz }, c[3] = { cx, cy, cz }, d[3] = { dx, dy, dz };
+		for (int axis = 0; axis < 3; axis++)
+		{
+			twoDiff(b[axis], a[axis], ba[axis][1], ba[axis][0]);
+			twoDiff(c[axis], a[axis], ca[axis][1], ca[axis][0]);
+			twoDiff(d[axis], a[axis], da[axis][1], da[axis][0]);
+		}
+
+		// The six terms of the determinant, each a product of three differences
+		double expansion[192];
+		int length = 0;
+		addTripleProduct(da[0], ba[1], ca[2], 1.0, expansion, length);
+		addTripleProduct(da[0], ba[2], ca[1], -1.0, expansion, length);
+		addTripleProduct(da[1], ba[2], ca[0], 1.0, expansion, length);
+		addTripleProduct(da[1], ba[0], ca[2], -1.0, expansion, length);
+		addTripleProduct(da[2], ba[0], ca[1], 1.0, expansion, length);
+		addTripleProduct(da[2], ba[1], ca[0], -1.0, expansion, length);
+
+		for (int i = length - 1; i >= 0; i--)
+		{
+			if (expansion[i] != 0.0)
+				return expansion[i];
+		}
+		return 0.0;
+	}
+	// Adds sign * a * b * c to the expansion, where a, b and c are exact as the sum of their two parts
+	// Each product of two doubles is two doubles, so this adds up to 32 parts
+	static void addTripleProduct(const double a[2], const double b[2], const double c[2], double sign, double* expansion, int& length)
+	{
+		for (int i = 0; i < 2; i++)
+		{
+			for (int j = 0; j < 2; j++)
+			{
+				double parts[2];
+				twoProduct(a[i], b[j], parts[1], parts[0]);
+				for (int part = 0; part < 2; part++)
+				{
+					if (parts[part] == 0.0)
+						continue;
+					for (int k = 0; k < 2; k++)
+					{
+						double product, error;
+						twoProduct(parts[part], c[k], product, error);
+						growExpansion(expansion, length, sign * error);
+						growExpansion(expansion, length, sign * product);
+					}
+				}
+			}
+		}
+	}
+
+	// a + b = sum + error exactly
+	static void twoSum(double a, double b, double& sum, double& error)
+	{
+		sum = a + b;
+		double bVirtual = sum - a;
+		double aVirtual = sum - bVirtual;
+		error = (a - aVirtual) + (b - bVirtual);
+	}
+	static void twoDiff(double a, double b, double& difference, double& error)
+	{
+		twoSum(a, -b, difference, error);
+	}
+	// Splits a into two halves of 26 bits that multiply without rounding
+	static void split(double a, double& high, double& low)
+	{
+		double c = 134217729.0 * a; // 2^27 + 1
+		double big = c - a;
+		high = c - big;
+		low = a - high;
+	}
+	// a * b = product + error exactly
+	static void twoProduct(double a, double b, double& product, double& error)
+	{
+		product = a * b;
+		double aHigh, aLow, bHigh, bLow;
+		split(a, aHigh, aLow);
+		split(b, bHigh, bLow);
+		double error1 = product - aHigh * bHigh;
+		double error2 = error1 - aLow * bHigh;
+		double error3 = error2 - aHigh * bLow;
+		error = aLow * bLow - error3;
+	}
+	// Adds value to the expansion in place, keeping it sorted by size and not overlapping
+	static void growExpansion(double* expansion, int& length, double value)
+	{
+		if (value == 0.0)
+			return;
+		for (int i = 0; i < length; i++)
+			twoSum(value, expansion[i], value, expansion[i]);
+		expansion[length++] = value;
+	}
+};
+
+// The orientation test for each coordinate type BasicQuickHullSoA takes, picked when it is compiled so
+// the engine's loops call it directly. Each gives the sign of the cross product exactly
+template <typename Scalar>
+struct ScalarPredicates;
+
+template <>
+struct ScalarPredicates<float>
+{
+	static const char* getName()
+	{
+		return "float";
+	}
+	static double orientation(float ax, float ay, float bx, float by, float cx, float cy)
+	{
+		return HullPredicates::orientation(ax, ay, bx, by, cx, cy);
+	}
+};
+
+template <>
+struct ScalarPredicates<double>
+{
+	static const char* getName()
+	{
+		return "double";
+	}
+	static double orientation(double ax, double ay, double bx, double by, double cx, double cy)
+	{
+		return HullPredicates::orientation(ax, ay, bx, by, cx, cy);
+	}
+};
+
+template <>
+struct ScalarPredicates<int32_t>
+{
+	static const char* getName()
+	{
+		return "int32";
+	}
+	// Differences under 2^31 give products under 2^62, so the cross product is exact in 64 bits.
+	// Points further apart than that go through the double test, every int32_t is exact as a double
+	static double orientation(int32_t ax, int32_t ay, int32_t bx, int32_t by, int32_t cx, int32_t cy)
+	{
+		int64_t acx = int64_t(ax) - cx;
+		int64_t acy = int64_t(ay) - cy;
+		int64_t bcx = int64_t(bx) - cx;
+		int64_t bcy = int64_t(by) - cy;
+		if (fitsProduct(acx) && fitsProduct(acy) && fitsProduct(bcx) && fitsProduct(bcy))
+			return double(acx * bcy - acy * bcx);
+		return HullPredicates::orientation(double(ax), double(ay), double(bx), double(by), double(cx), double(cy));
+	}
+
+private:
+	static bool fitsProduct(int64_t difference)
+	{
+		return difference > -(int64_t(1) << 31) && difference < (int64_t(1) << 31);
+	}
+};
@@ -0,0 +1,235 @@
+// HullProfiler.h
+// Nathan Damon
+// 2026-10-16
+// Timings and counts of the phases of a hull run
+//
+// An engine given a profiler times its phases with Scope, which records a
+// named event with its start, length, nesting depth and thread. Each split
+// of the recursion is added to the totals of its depth with addSplit, and
+// anything else worth counting goes in with addCount. Without a profiler a
+// Scope only checks a pointer, so the engines run the same as before when
+// it is off. QuickHullSim draws the last run as an overlay, and
+// writeChromeTrace saves it in the Trace Event format that
+// chrome://tracing and Perfetto open.
+//
+// Recording takes a lock, so the tasks of a parallel run can share one
+// profiler. Nothing may read it while a run is recording.
+
+#pragma once
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <fstream>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
+
+class HullProfiler
+{
+public:
+	// A timed phase, the times are steady clock nanoseconds
+	struct Event
+	{
+		std::string _name;
+		int64_t _start = 0;
+		int64_t _duration = 0;
+		uint32_t _depth = 0; // Scopes that were open around it on the same thread
+		uint32_t _thread = 0;
+	};
+	// Totals of the splits at one depth of the recursion, the first split of all the points is depth 0
+	struct Level
+	{
+		size_t _splitCount = 0;
+		size_t _pointsExamined = 0;
+		size_t _pointsKept = 0; // Points outside the two new lines, the rest were inside the triangle
+		size_t _largestPartition = 0;
+		int64_t _farthestNanoseconds = 0; // Only for engines that look for the farthest point in a pass of its own
+		int64_t _splitNanoseconds = 0;
+	};
+	struct Counter
+	{
+		std::string _name;
+		uint64_t _value = 0;
+	};
+
+	// Times the code from here to the end of the block
+	class Scope
+	{
+	public:
+		Scope(HullProfiler* profiler, const char* name) : _profiler(profiler), _name(name)
+		{
+			if (_profiler)
+			{
+				_depth = openScopes()++;
+				_start = now();
+			}
+		}
+		~Scope()
+		{
+			if (_profiler)
+			{
+				int64_t end = now();
+				openScopes()--;
+				_profiler->addEvent(_name, _start, end - _start, _depth);
+			}
+		}
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+
+	private:
+		HullProfiler* _profiler;
+		const char* _name;
+		int64_t _start = 0;
+		uint32_t _depth = 0;
+	};
+
+public:
+	HullProfiler() {}
+	~HullProfiler() {}
+
+	// Called before a run, so only that run is shown
+	void clear()
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		_events.clear();
+		_levels.clear();
+		_counters.clear();
+	}
+
+	void addEvent(const char* name, int64_t start, int64_t duration, uint32_t depth)
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		Event event;
+		event._name = name;
+		event._start = start;
+		event._duration = duration;
+		event._depth = depth;
+		event._thread = getThreadIndex();
+		_events.push_back(event);
+	}
+	// A range of examined points split into one of firstCount points and one of secondCount points
+	void addSplit(size_t depth, size_t examined, size_t firstCount, size_t secondCount, int64_t splitNanoseconds, int64_t farthestNanoseconds = 0)
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		if (_levels.size() <= depth)
+			_levels.resize(depth + 1);
+		Level& level = _levels[depth];
+		level._splitCount++;
+		level._pointsExamined += examined;
+		level._pointsKept += firstCount + secondCount;
+		level._largestPartition = std::max(level._largestPartition, std::max(firstCount, secondCount));
+		level._splitNanoseconds += splitNanoseconds;
+		level._farthestNanoseconds += farthestNanoseconds;
+	}
+	// Adds value to the named counter
+	void addCount(const char* name, uint64_t value)
+	{
+		std::lock_guard<std::mutex> lock(_lock);
+		for (auto& counter : _counters)
+		{
+			if (counter._name == name)
+			{
+				counter._value += value;
+				return;
+			}
+		}
+		_counters.push_back({ name, value });
+	}
+
+	const std::vector<Event>& getEvents() const
+	{
+		return _events;
+	}
+	const std::vector<Level>& getLevels() const
+	{
+		return _levels;
+	}
+	const std::vector<Counter>& getCounters() const
+	{
+		return _counters;
+	}
+	// Start of the first event and end of the last one
+	int64_t getStart() const
+	{
+		int64_t start = _events.empty() ? 0 : _events.front()._start;
+		for (auto& event : _events)
+			start = std::min(start, event._start);
+		return start;
+	}
+	int64_t getEnd() const
+	{
+		int64_t end = 0;
+		for (auto& event : _events)
+			end = std::max(end, event._start + event._duration);
+		return end;
+	}
+
+	// The events go on their threads' rows. The totals of each depth go one after another on a row of
+	// their own, so the time of each depth can be compared even though the depths take turns while running
+	// Returns false when the file could not be written
+	bool writeChromeTrace(const std::string& fileName) const
+	{
+		std::ofstream out(fileName);
+		if (out.is_open() == false)
+			return false;
+
+		const int64_t start = getStart();
+		const uint32_t levelThread = 1000;
+		out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n";
+		out << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << levelThread << ", \"args\": {\"name\": \"Split totals by depth\"}}";
+		for (auto& event : _events)
+		{
+			out << ",\n  {\"name\": \"" << event._name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << event._thread
+				<< ", \"ts\": " << toMicroseconds(event._start - start) << ", \"dur\": " << toMicroseconds(event._duration) << "}";
+		}
+
+		int64_t levelStart = 0;
+		for (size_t depth = 0; depth < _levels.size(); depth++)
+		{
+			const Level& level = _levels[depth];
+			int64_t duration = level._splitNanoseconds + level._farthestNanoseconds;
+			out << ",\n  {\"name\": \"depth " << depth << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << levelThread
+				<< ", \"ts\": " << toMicroseconds(levelStart) << ", \"dur\": " << toMicroseconds(duration)
+				<< ", \"args\": {\"splits\": " << level._splitCount << ", \"points examined\": " << level._pointsExamined
+				<< ", \"points kept\": " << level._pointsKept << ", \"largest partition\": " << level._largestPartition
+				<< ", \"farthest point us\": " << toMicroseconds(level._farthestNanoseconds) << "}}";
+			levelStart += duration;
+		}
+
+		for (auto& counter : _counters)
+			out << ",\n  {\"name\": \"" << counter._name << "\", \"ph\": \"C\", \"pid\": 1, \"ts\": 0, \"args\": {\"value\": " << counter._value << "}}";
+		out << ",\n  {\"name\": \"recursion depth\", \"ph\": \"C\", \"pid\": 1, \"ts\": 0, \"args\": {\"value\": " << _levels.size() << "}}";
+		out << "\n]}\n";
+		return bool(out);
+	}
+
+	static int64_t now()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+private:
+	static double toMicroseconds(int64_t nanoseconds)
+	{
+		return double(nanoseconds) / 1000.0;
+	}
+	static uint32_t& openScopes()
+	{
+		static thread_local uint32_t count = 0;
+		return count;
+	}
+	// Small thread numbers in the order the threads first record something
+	static uint32_t getThreadIndex()
+	{
+		static std::atomic<uint32_t> nextIndex{ 0 };
+		static thread_local uint32_t index = nextIndex++;
+		return index;
+	}
+
+private:
+	std::mutex _lock;
+	std::vector<Event> _events;
+	std::vector<Level> _levels;
+	std::vector<Counter> _counters;
+};
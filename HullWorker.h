@@ -0,0 +1,151 @@
+// HullWorker.h
+// Nathan Damon
+// 2026-10-16
+// Runs a hull engine on its own thread
+//
+// The window keeps drawing while a large hull is worked out. The engine
+// pushes each hull edge it finishes to a lock-free SpscQueue, which the
+// render loop drains every frame to show the run as it goes, and the
+// finished hull is handed over once the run is done. QuickHullSoA pushes
+// an edge when a range has no points left above it and Chan pushes each
+// edge it wraps. The monotone chain and dynamic engines only know their
+// edges at the end, so nothing shows until their run is done. The thread is started once
+// and waits for runs, so starting a run does not create a thread.
+//
+// An engine can not be stopped part way through, so anything that would
+// change the points or the engine of a run waits for it to finish.
+
+#pragma once
+#include "HullEngine.h"
+#include "SpscQueue.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+class HullWorker
+{
+public:
+	HullWorker() : _progressQueue(1 << 16)
+	{
+		_thread = std::thread([this]() { workLoop(); });
+	}
+	~HullWorker()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			_stopping = true;
+		}
+		_wake.notify_one();
+		_thread.join();
+	}
+	HullWorker(const HullWorker&) = delete;
+	HullWorker& operator=(const HullWorker&) = delete;
+
+	// Runs engine on points on the worker thread, debugEdges asks for the engine's debug lines
+	// Neither may be changed until the run is done
+	void start(HullEngine& engine, HullPoints& points, bool debugEdges)
+	{
+		wait();
+
+		// Edges of the last run that were never drained
+		HullEdge edge;
+		while (_progressQueue.tryPop(edge)) {}
+
+		_edges.clear();
+		_debugEdges.clear();
+		_engine = &engine;
+		_points = &points;
+		_wantDebugEdges = debugEdges;
+		{
+			std::lock_guard<std::mutex> lock(_lock);
+			_running.store(true, std::memory_order_relaxed);
+			_runPending = true;
+		}
+		_wake.notify_one();
+	}
+
+	bool isRunning() const
+	{
+		return _running.load(std::memory_order_acquire);
+	}
+	// Blocks until the run in progress is done
+	void wait()
+	{
+		std::unique_lock<std::mutex> lock(_lock);
+		_done.wait(lock, [this]() { return _running.load(std::memory_order_relaxed) == false; });
+	}
+
+	// Moves the hull edges finished since the last call onto the end of edges, for the render thread only
+	void drainProgress(std::vector<HullEdge>& edges)
+	{
+		HullEdge edge;
+		while (_progressQueue.tryPop(edge))
+			edges.push_back(edge);
+	}
+
+	// Swaps the hull and debug lines of the finished run into edges and debugEdges
+	// Swapping keeps both sides' memory, so taking the results does not allocate
+	void takeResults(std::vector<HullEdge>& edges, std::vector<HullEdge>& debugEdges)
+	{
+		wait();
+		edges.swap(_edges);
+		debugEdges.swap(_debugEdges);
+	}
+
+	// Milliseconds the last run's computeHull took
+	float getRunTime() const
+	{
+		return _runTime;
+	}
+
+private:
+	void workLoop()
+	{
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(_lock);
+				_wake.wait(lock, [this]() { return _runPending || _stopping; });
+				if (_stopping)
+					return;
+				_runPending = false;
+			}
+
+			_engine->setProgressQueue(&_progressQueue);
+			auto timeStart = std::chrono::steady_clock::now();
+			_engine->computeHull(*_points, _edges, _wantDebugEdges ? &_debugEdges : nullptr);
+			std::chrono::duration<float> timeTaken = std::chrono::steady_clock::now() - timeStart;
+			_runTime = timeTaken.count() * 1000.0f;
+			_engine->setProgressQueue(nullptr);
+
+			// The release makes the results seen by a thread that sees _running go false
+			{
+				std::lock_guard<std::mutex> lock(_lock);
+				_running.store(false, std::memory_order_release);
+			}
+			_done.notify_all();
+		}
+	}
+
+private:
+	std::thread _thread;
+	std::mutex _lock;
+	std::condition_variable _wake;
+	std::condition_variable _done;
+	bool _runPending = false; // A run was started and the worker has not picked it up yet
+	bool _stopping = false;
+	std::atomic<bool> _running{ false };
+
+	// The run, set before it starts
+	HullEngine* _engine = nullptr;
+	HullPoints* _points = nullptr;
+	bool _wantDebugEdges = false;
+
+	// Results, only touched by the worker while _running is true
+	SpscQueue<HullEdge> _progressQueue;
+	std::vector<HullEdge> _edges;
+	std::vector<HullEdge> _debugEdges;
+	float _runTime = 0.0f;
+};
@@ -0,0 +1,362 @@
+// IntegerQuickHull.h
+// Nathan Damon
+// 2026-10-16
+// QuickHull on points snapped to an integer grid
+//
+// The points are moved to the corner of their bounding box, scaled by a
+// power of two, the same one for x and y, that fits the box on a square
+// grid and rounded to the nearest grid point, then QuickHull is run on the
+// grid coordinates with integer cross products. Those are exact, so no
+// predicate can come out wrong and nothing needs a fallback. With 32 bit
+// coordinates the grid is 2^30 wide, which keeps every cross product
+// inside 64 bits. With 16 bit coordinates it is 2^15 wide, the cross
+// products fit in 32 bits and a point of the working copy takes 8 bytes
+// instead of the 12 of QuickHullSoA, which is plenty for points that end
+// up on a screen.
+//
+// The hull is exact for the grid points. A power of two scale does not
+// move a point whose scaled coordinates are already whole, so small integer
+// inputs and the like give the same hull as the float engines. Other points
+// are rounded by up to half a grid step, which can change the hull both
+// ways: a corner can round onto a line or onto another point and be left
+// out, and a point just inside an edge can round onto or past it and be
+// kept as a corner that the float engines do not have.
+//
+// Each range is split in place with a three way partition: the points
+// outside A-C to the front, then the points outside C-B, then the rest.
+// The hull comes out in counter clockwise order through the same output
+// slots as QuickHullSoA, and the ranges left to split are kept on a small
+// fixed size stack in the same way.
+
+#pragma once
+#include "HullEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+template <typename Coordinate>
+class IntegerQuickHull : public HullEngine
+{
+	static_assert(std::is_same<Coordinate, int16_t>::value || std::is_same<Coordinate, int32_t>::value,
+		"Grid coordinates are int16_t or int32_t");
+
+public:
+	// Every cross product of grid points fits in a Product
+	using Product = typename std::conditional<sizeof(Coordinate) == 2, int32_t, int64_t>::type;
+	static constexpr int _gridBits = sizeof(Coordinate) == 2 ? 15 : 30;
+	static constexpr Coordinate _gridMax = Coordinate((int64_t(1) << _gridBits) - 1);
+
+	// Working copy of the points in grid coordinates
+	struct Buffer
+	{
+		std::vector<Coordinate> _x;
+		std::vector<Coordinate> _y;
+		std::vector<uint32_t> _index;
+
+		void resize(size_t count)
+		{
+			_x.resize(count);
+			_y.resize(count);
+			_index.resize(count);
+		}
+		void swap(size_t a, size_t b)
+		{
+			std::swap(_x[a], _x[b]);
+			std::swap(_y[a], _y[b]);
+			std::swap(_index[a], _index[b]);
+		}
+	};
+
+	// A grid point and the index of the point it came from
+	struct Vertex
+	{
+		Coordinate _x = 0;
+		Coordinate _y = 0;
+		uint32_t _index = 0;
+	};
+
+public:
+	IntegerQuickHull() {}
+	~IntegerQuickHull() {}
+
+	std::string getName() const override
+	{
+		return sizeof(Coordinate) == 2 ? "QuickHullInt16" : "QuickHullInt32";
+	}
+
+	bool computeHull(HullPoints& points, std::vector<HullEdge>& edges, std::vector<HullEdge>* debugEdges = nullptr) override
+	{
+		HullProfiler::Scope runScope(_profiler, sizeof(Coordinate) == 2 ? "QuickHullInt16" : "QuickHullInt32");
+		points.clearOnHull();
+		_hullOrder.clear();
+		size_t n = points.size();
+		if (n == 0)
+			return true;
+
+		{
+			HullProfiler::Scope scope(_profiler, "quantize");
+			quantize(points);
+		}
+
+		// Least x is left and greatest x is right, ties are broken on y so they are only
+		// the same grid point when every point is
+		Vertex A = getVertex(0);
+		Vertex B = A;
+		{
+			HullProfiler::Scope scope(_profiler, "min/max scan");
+			for (size_t i = 1; i < n; i++)
+			{
+				Coordinate x = _buffer._x[i];
+				Coordinate y = _buffer._y[i];
+				if (x < A._x || (x == A._x && y < A._y))
+					A = getVertex(i);
+				if (x > B._x || (x == B._x && y > B._y))
+					B = getVertex(i);
+			}
+		}
+		if (A._x == B._x && A._y == B._y)
+		{
+			_hullOrder.push_back(A._index);
+			addHullEdges(points, edges);
+			return true;
+		}
+
+		_debugEdges = debugEdges;
+		if (_debugEdges)
+			_debugEdges->push_back({ A._index, B._index });
+
+		// The points outside A-B and then the ones outside B-A, which is the other side of the same line
+		Partition split;
+		{
+			HullProfiler::Scope scope(_profiler, "splitAllPoints");
+			int64_t splitStart = _profiler ? HullProfiler::now() : 0;
+			split = partition(0, n, A, B, A);
+			if (_profiler)
+			{
+				_profiler->addSplit(0, n, split._firstCount, split._secondCount, HullProfiler::now() - splitStart);
+				_profiler->addCount("points", n);
+			}
+		}
+
+		// A, the first chain, B, then the second chain
+		const size_t secondOutput = split._firstCount + 2;
+		clearHullSlots(secondOutput + split._secondCount);
+		_hullSlots[0] = A;
+		_hullSlots[secondOutput - 1] = B;
+
+		QuickHullSub(A, B, 0, split._firstCount, split._firstFarthest, 1);
+		QuickHullSub(B, A, split._firstCount, split._secondCount, split._secondFarthest, secondOutput);
+
+		_hullVertices.clear();
+		for (size_t i = 0; i < secondOutput + split._secondCount; i++)
+		{
+			if (_hullSlots[i]._index != _emptySlot)
+				_hullVertices.push_back(_hullSlots[i]);
+		}
+		{
+			HullProfiler::Scope scope(_profiler, "removeFlatVertices");
+			_hullVertices.resize(removeFlatHullVertices(_hullVertices.data(), _hullVertices.size(), isFlatTurn));
+		}
+		for (auto& vertex : _hullVertices)
+			_hullOrder.push_back(vertex._index);
+		addHullEdges(points, edges);
+
+		_debugEdges = nullptr;
+		return true;
+	}
+
+	// Exact twice the signed area of O, A, B, positive when they turn counter clockwise
+	static Product orientation(Coordinate ox, Coordinate oy, Coordinate ax, Coordinate ay, Coordinate bx, Coordinate by)
+	{
+		return (Product(ax) - ox) * (Product(by) - oy) - (Product(ay) - oy) * (Product(bx) - ox);
+	}
+
+private:
+	// A range of the buffer still to be split, the points in it are outside A-B
+	struct Frame
+	{
+		Vertex _A;
+		Vertex _B;
+		size_t _rangeStart;
+		size_t _rangeCount;
+		Vertex _farthest; // The point farthest outside A-B, found when the range was split
+		size_t _outputStart; // First of the _rangeCount hull slots for the hull points between A and B
+		size_t _depth; // Splits since the first one, for the profiler
+	};
+
+	struct Partition
+	{
+		size_t _firstCount = 0;
+		size_t _secondCount = 0;
+		Vertex _firstFarthest;
+		Vertex _secondFarthest;
+	};
+
+	// Scales the bounding box of the points onto the grid and rounds them into the buffer
+	// The scale is a power of two so the scaling itself is exact and only the rounding moves points
+	void quantize(const HullPoints& points)
+	{
+		size_t n = points.size();
+		float minX = points._x[0], maxX = points._x[0];
+		float minY = points._y[0], maxY = points._y[0];
+		for (size_t i = 1; i < n; i++)
+		{
+			minX = std::min(minX, points._x[i]);
+			maxX = std::max(maxX, points._x[i]);
+			minY = std::min(minY, points._y[i]);
+			maxY = std::max(maxY, points._y[i]);
+		}
+		double extent = std::max(double(maxX) - minX, double(maxY) - minY);
+		double scale = 1.0;
+		if (extent > 0.0)
+		{
+			// extent is below 2^exponent, so extent * 2^(gridBits - exponent) is below 2^gridBits,
+			// but it can still be past _gridMax, which is one less
+			int exponent = 0;
+			std::frexp(extent, &exponent);
+			scale = std::ldexp(1.0, _gridBits - exponent);
+			if (extent * scale > double(_gridMax))
+				scale *= 0.5;
+		}
+
+		_buffer.resize(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			_buffer._x[i] = Coordinate((double(points._x[i]) - minX) * scale + 0.5);
+			_buffer._y[i] = Coordinate((double(points._y[i]) - minY) * scale + 0.5);
+			_buffer._index[i] = uint32_t(i);
+		}
+	}
+
+	// Works through the ranges left after a split with a fixed size stack instead of recursing
+	// The smaller of the two new ranges is done next, so the stack never holds more than log2(n) frames
+	void QuickHullSub(const Vertex& A, const Vertex& B, size_t rangeStart, size_t rangeCount, const Vertex& farthest, size_t outputStart)
+	{
+		HullProfiler::Scope scope(_profiler, "QuickHullSub");
+		Frame stack[_maxStackDepth];
+		size_t stackSize = 0;
+
+		Frame frame = { A, B, rangeStart, rangeCount, farthest, outputStart, 1 };
+		while (true)
+		{
+			if (frame._rangeCount == 0)
+			{
+				// No points are above A-B, so it is an edge of the hull
+				addProgressEdge(frame._A._index, frame._B._index);
+				if (stackSize == 0)
+					return;
+				frame = stack[--stackSize];
+				continue;
+			}
+
+			const Vertex C = frame._farthest;
+			if (_debugEdges)
+			{
+				_debugEdges->push_back({ frame._A._index, C._index });
+				_debugEdges->push_back({ frame._B._index, C._index });
+			}
+
+			// Divide, the farthest points of the two sides are found in the same pass
+			int64_t splitStart = _profiler ? HullProfiler::now() : 0;
+			Partition split = partition(frame._rangeStart, frame._rangeCount, frame._A, C, frame._B);
+			if (_profiler)
+				_profiler->addSplit(frame._depth, frame._rangeCount, split._firstCount, split._secondCount, HullProfiler::now() - splitStart);
+			Frame left = { frame._A, C, frame._rangeStart, split._firstCount, split._firstFarthest, frame._outputStart, frame._depth + 1 };
+			Frame right = { C, frame._B, frame._rangeStart + split._firstCount, split._secondCount, split._secondFarthest,
+				frame._outputStart + split._firstCount + 1, frame._depth + 1 };
+
+			// C is on neither side, so both sides and C fit in this range's slots
+			_hullSlots[frame._outputStart + split._firstCount] = C;
+			if (left._rangeCount > right._rangeCount)
+				std::swap(left, right);
+			stack[stackSize++] = right;
+			frame = left;
+		}
+	}
+
+	// Puts the points of the range outside P-Q at its front, then the points outside Q-R, then the rest
+	// P-Q and Q-R are two edges in order around the hull, so no point is outside both
+	// The farthest point outside each edge is found in the same pass
+	Partition partition(size_t start, size_t count, const Vertex& P, const Vertex& Q, const Vertex& R)
+	{
+		const Product firstDx = Product(Q._x) - P._x;
+		const Product firstDy = Product(Q._y) - P._y;
+		const Product secondDx = Product(R._x) - Q._x;
+		const Product secondDy = Product(R._y) - Q._y;
+		Product firstFarthest = 0;
+		Product secondFarthest = 0;
+
+		Partition result;
+		size_t low = start;
+		size_t middle = start;
+		size_t high = start + count;
+		while (middle < high)
+		{
+			const Product x = _buffer._x[middle];
+			const Product y = _buffer._y[middle];
+
+			// How far outside an edge going counter clockwise around the hull, which is to its right
+			const Product first = firstDy * (x - P._x) - firstDx * (y - P._y);
+			if (first > 0)
+			{
+				if (first > firstFarthest)
+				{
+					firstFarthest = first;
+					result._firstFarthest = getVertex(middle);
+				}
+				_buffer.swap(low++, middle++);
+				continue;
+			}
+			const Product second = secondDy * (x - Q._x) - secondDx * (y - Q._y);
+			if (second > 0)
+			{
+				if (second > secondFarthest)
+				{
+					secondFarthest = second;
+					result._secondFarthest = getVertex(middle);
+				}
+				middle++;
+			}
+			else
+				_buffer.swap(middle, --high);
+		}
+
+		result._firstCount = low - start;
+		result._secondCount = middle - low;
+		return result;
+	}
+
+	Vertex getVertex(size_t position) const
+	{
+		return { _buffer._x[position], _buffer._y[position], _buffer._index[position] };
+	}
+
+	// Marks the first count slots as empty, the slots are kept between runs
+	void clearHullSlots(size_t count)
+	{
+		if (_hullSlots.size() < count)
+			_hullSlots.resize(count);
+		Vertex empty;
+		empty._index = _emptySlot;
+		std::fill(_hullSlots.begin(), _hullSlots.begin() + count, empty);
+	}
+
+	// A farthest point can tie with another on a line parallel to the edge, so it is not always a
+	// corner. A is always one, so the hull can be walked from it
+	static bool isFlatTurn(const Vertex& a, const Vertex& b, const Vertex& c)
+	{
+		return orientation(a._x, a._y, b._x, b._y, c._x, c._y) <= 0;
+	}
+
+private:
+	Buffer _buffer;
+
+	// Enough for the log2(n) frames of any range a uint32_t can index
+	static constexpr size_t _maxStackDepth = 64;
+
+	// Outputs for the run in progress
+	static constexpr uint32_t _emptySlot = 0xFFFFFFFF;
+	std::vector<Vertex> _hullSlots; // Hull points in order with gaps between them
+	std::vector<Vertex> _hullVertices;
+	std::vector<HullEdge>* _debugEdges = nullptr;
+};
@@ -0,0 +1,284 @@
+// KineticHull.h
+// Nathan Damon
+// 2026-10-16
+// Keeps the hull of moving points up to date from frame to frame
+//
+// A full build runs QuickHull on all of the points and keeps the points
+// within a band of width W inside the hull as candidates. The hull's edges
+// are moved in by W and cut against each other in order around it, and a
+// point strictly inside that smaller polygon, found with a binary search
+// like HullPolygon::contains, is at least W inside the hull, which is its
+// certificate. When the points have moved at most D in all since the
+// build, the hull of the candidates' hull points has moved at most D and
+// still holds everything that was more than D inside the old hull, so
+// while 2D is no more than W no other point can be on the hull. Each
+// update then only takes the hull of the candidates.
+//
+// The candidates are kept sorted by x between updates, so the insertion
+// sort that puts them back in order only does as much work as the points
+// that passed each other. Once the drift uses up the band, the next update
+// is a full build with a band as wide as _rebuildFrames moves, so the cost
+// of a build is spread over that many frames. When nearly every point is
+// close to the hull, as on the circle, they are all candidates and an
+// update costs about as much as a full run. Moving the points is still up
+// to the caller.
+
+#pragma once
+#include "HullEngine.h"
+#include "QuickHullSoA.h"
+#include "MonotoneChainHull.h"
+#include <algorithm>
+
+class KineticHull : public HullEngine
+{
+public:
+	KineticHull() {}
+	~KineticHull() {}
+
+	std::string getName() const override
+	{
+		return "KineticHull";
+	}
+
+	// A full build, the band is the width of the last one
+	bool computeHull(HullPoints& points, std::vector<HullEdge>& edges, std::vector<HullEdge>* debugEdges = nullptr) override
+	{
+		HullProfiler::Scope runScope(_profiler, "KineticHull");
+		(void)debugEdges;
+		rebuild(points, _bandWidth);
+		addHullEdges(points, edges);
+		return true;
+	}
+
+	// Catches up with points that each moved at most maxMove since the last call
+	// Returns false when it had to do a full build instead
+	bool update(HullPoints& points, float maxMove, std::vector<HullEdge>& edges)
+	{
+		HullProfiler::Scope runScope(_profiler, "KineticHull update");
+		_drift += maxMove;
+		bool seeded = _buildPointCount == points.size() && 2.0f * _drift <= _bandWidth;
+		if (seeded)
+		{
+			for (uint32_t index : _hullOrder)
+				points.clearAsOnHull(index);
+			_hullOrder.clear();
+			HullProfiler::Scope scope(_profiler, "candidate hull");
+			computeCandidateHull(points);
+		}
+		else
+			rebuild(points, 2.0f * float(_rebuildFrames) * maxMove);
+		addHullEdges(points, edges);
+		return seeded;
+	}
+
+	// Updates between full builds when the points move the same distance each frame
+	void setRebuildFrames(size_t frames)
+	{
+		_rebuildFrames = std::max(size_t(1), frames);
+	}
+	size_t getRebuildFrames() const
+	{
+		return _rebuildFrames;
+	}
+	// Points whose hull was taken in the last update
+	size_t getCandidateCount() const
+	{
+		return _candidates.size();
+	}
+
+private:
+	// The hull of every point and the points within bandWidth of it
+	void rebuild(HullPoints& points, float bandWidth)
+	{
+		_quickHull.setProfiler(_profiler);
+		_edges.clear();
+		_quickHull.computeHull(points, _edges);
+		_hullOrder = _quickHull.getHullOrder();
+		_drift = 0.0f;
+		_bandWidth = bandWidth;
+
+		HullProfiler::Scope scope(_profiler, "find candidates");
+		_candidates.clear();
+		if (bandWidth <= 0.0f)
+		{
+			// Without a band the next update that moves anything builds again
+			_candidates = _hullOrder;
+		}
+		else if (shrinkHull(points, double(bandWidth) * 1.0625))
+		{
+			// The smaller polygon is worked out in double, the wider band keeps its rounding on the safe side
+			for (uint32_t i = 0; i < points.size(); i++)
+			{
+				if (isInsideShrunkHull(points._x[i], points._y[i]) == false)
+					_candidates.push_back(i);
+			}
+		}
+		else
+		{
+			// The band covers the whole hull, points in a line also end up here
+			_candidates.resize(points.size());
+			for (uint32_t i = 0; i < points.size(); i++)
+				_candidates[i] = i;
+		}
+		_buildPointCount = points.size();
+
+		std::sort(_candidates.begin(), _candidates.end(), [&points](uint32_t a, uint32_t b)
+			{
+				return isBefore(points, a, b);
+			});
+	}
+
+	// Puts the candidates back in order by x and walks them with the monotone chain
+	void computeCandidateHull(HullPoints& points)
+	{
+		// Insertion sort, each point only moves past the ones it passed since the last update
+		for (size_t i = 1; i < _candidates.size(); i++)
+		{
+			uint32_t index = _candidates[i];
+			size_t j = i;
+			while (j > 0 && isBefore(points, index, _candidates[j - 1]))
+			{
+				_candidates[j] = _candidates[j - 1];
+				j--;
+			}
+			_candidates[j] = index;
+		}
+
+		size_t count = _candidates.size();
+		_x.resize(count);
+		_y.resize(count);
+		_chain.resize(count + 1);
+		for (size_t i = 0; i < count; i++)
+		{
+			_x[i] = points._x[_candidates[i]];
+			_y[i] = points._y[_candidates[i]];
+		}
+		size_t hullCount = MonotoneChainHull::chain(_x.data(), _y.data(), count, _chain.data());
+		for (size_t i = 0; i < hullCount; i++)
+			_hullOrder.push_back(_candidates[_chain[i]]);
+	}
+
+	// A line through a point, the side to the left of its direction is kept
+	struct Line
+	{
+		double _x;
+		double _y;
+		double _dx;
+		double _dy;
+	};
+
+	// Puts the hull moved in by width, the points at least width inside every edge, in _innerX and _innerY.
+	// Each edge's line is moved in and the lines are cut against each other in order around the hull,
+	// which drops the edges too short to be left. Returns false when nothing is left
+	bool shrinkHull(const HullPoints& points, double width)
+	{
+		size_t count = _hullOrder.size();
+		if (count < 3)
+			return false;
+
+		// The lines are already in order of their angle, so a deque of them is enough to cut them
+		_lines.resize(count);
+		size_t head = 0;
+		size_t tail = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			uint32_t a = _hullOrder[i];
+			uint32_t b = _hullOrder[(i + 1) % count];
+			double dx = double(points._x[b]) - points._x[a];
+			double dy = double(points._y[b]) - points._y[a];
+			double offset = width / std::sqrt(dx * dx + dy * dy);
+			Line line = { points._x[a] - dy * offset, points._y[a] + dx * offset, dx, dy };
+
+			double x, y;
+			while (tail - head >= 2 && (intersect(_lines[tail - 2], _lines[tail - 1], x, y) == false || isLeftOf(line, x, y) == false))
+				tail--;
+			while (tail - head >= 2 && (intersect(_lines[head], _lines[head + 1], x, y) == false || isLeftOf(line, x, y) == false))
+				head++;
+			_lines[tail++] = line;
+		}
+		double x, y;
+		while (tail - head >= 3 && (intersect(_lines[tail - 2], _lines[tail - 1], x, y) == false || isLeftOf(_lines[head], x, y) == false))
+			tail--;
+		while (tail - head >= 3 && (intersect(_lines[head], _lines[head + 1], x, y) == false || isLeftOf(_lines[tail - 1], x, y) == false))
+			head++;
+		if (tail - head < 3)
+			return false;
+
+		_innerX.clear();
+		_innerY.clear();
+		for (size_t i = head; i < tail; i++)
+		{
+			if (intersect(_lines[i], _lines[i + 1 < tail ? i + 1 : head], x, y) == false)
+				return false;
+			_innerX.push_back(x);
+			_innerY.push_back(y);
+		}
+		return true;
+	}
+	// Where the two lines cross, false when they are parallel
+	static bool intersect(const Line& first, const Line& second, double& x, double& y)
+	{
+		double denominator = first._dx * second._dy - first._dy * second._dx;
+		if (denominator == 0.0)
+			return false;
+		double t = ((second._x - first._x) * second._dy - (second._y - first._y) * second._dx) / denominator;
+		x = first._x + t * first._dx;
+		y = first._y + t * first._dy;
+		return true;
+	}
+	static bool isLeftOf(const Line& line, double x, double y)
+	{
+		return line._dx * (y - line._y) - line._dy * (x - line._x) >= 0.0;
+	}
+
+	// True when the point is strictly inside the polygon of shrinkHull, O(log h)
+	// The first corner splits it into a fan of triangles, the one the point could be in is found
+	// with a binary search and then the point is checked against its outer edge
+	bool isInsideShrunkHull(double x, double y) const
+	{
+		size_t count = _innerX.size();
+		if (turn(0, 1, x, y) <= 0.0 || turn(0, count - 1, x, y) >= 0.0)
+			return false;
+		size_t low = 1;
+		size_t high = count - 1;
+		while (high - low > 1)
+		{
+			size_t middle = (low + high) / 2;
+			if (turn(0, middle, x, y) >= 0.0)
+				low = middle;
+			else
+				high = middle;
+		}
+		return turn(low, high, x, y) > 0.0;
+	}
+	// Positive when the point is left of the line from corner a to corner b
+	double turn(size_t a, size_t b, double x, double y) const
+	{
+		return (_innerX[b] - _innerX[a]) * (y - _innerY[a]) - (_innerY[b] - _innerY[a]) * (x - _innerX[a]);
+	}
+
+	static bool isBefore(const HullPoints& points, uint32_t a, uint32_t b)
+	{
+		return points._x[a] < points._x[b] || (points._x[a] == points._x[b] && points._y[a] < points._y[b]);
+	}
+
+private:
+	QuickHullSoA _quickHull;
+	std::vector<HullEdge> _edges; // The full build's edges, the hull is taken from its order
+
+	size_t _rebuildFrames = 8;
+	float _bandWidth = 0.0f;
+	float _drift = 0.0f; // How far any point can have moved since the last full build
+	size_t _buildPointCount = 0; // Points at the last full build, a different count needs another
+
+	// Candidates sorted by x, then y, kept between updates
+	std::vector<uint32_t> _candidates;
+	std::vector<float> _x;
+	std::vector<float> _y;
+	std::vector<uint32_t> _chain;
+
+	// The hull moved in by the band, kept between builds
+	std::vector<Line> _lines;
+	std::vector<double> _innerX;
+	std::vector<double> _innerY;
+};
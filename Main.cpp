@@ -7,11 +7,24 @@
 // This program was running on Visual Studio 2022, but should work for 
 // some of the previous ones. If using outside of Visual Studio and 
 // having issues, see: https://www.github.com/onelonecoder for possible 
-// fixes.
+// fixes. AllocationCounter.cpp has to be built into the program too.
 
 #define OLC_PGE_APPLICATION
 #include "olcPixelGameEngine.h"
-#include <random>
+#include "QuickHullSoA.h"
+#include "MonotoneChainHull.h"
+#include "ChanHull.h"
+#include "DynamicHull.h"
+#include "IntegerQuickHull.h"
+#include "QuickHull3D.h"
+#include "HullPolygon.h"
+#include "AllocationCounter.h"
+#include "PointDatasets.h"
+#include "StreamingHull.h"
+#include "HullWorker.h"
+#include "HullProfiler.h"
+#include "PointGrid.h"
+#include "KineticHull.h"
 #include <chrono>
 
 class QuickHullSim : public olc::PixelGameEngine
@@ -62,6 +75,15 @@ public:
 		olc::Pixel _color = olc::CYAN;
 	};
 
+	// Approximate hull modes of the structure-of-arrays QuickHull
+	enum class ApproximateMode
+	{
+		Off,
+		Tolerance,	// Leaves out hull points less than a pixel from the hull of the rest
+		VertexCount,	// The _approximateVertexCount points farthest out
+		Count
+	};
+
 public:
 	QuickHullSim()
 	{
@@ -71,11 +93,9 @@ public:
 public:
 	bool OnUserCreate() override
 	{
-		_uniDistX = std::uniform_real_distribution<float>(0.0f, 1.0f);
-		_uniDistY = std::uniform_real_distribution<float>(0.0f, 1.0f);
-
-		_points = std::vector<Point>(_pointCount);
-		placePointsUniformly();
+		_points.assign(_pointCount, Point());
+		_hullPoints.resize(_pointCount);
+		placePoints();
 
 		_scaleFactor = std::max(0.01f, std::min(_scaleFactor, float(GetScreenSize().x)));
 		_pointOffset = (olc::vf2d(GetScreenSize()) - olc::vf2d(1.0f, 1.0f) * _scaleFactor) * 0.5f;
@@ -89,56 +109,258 @@ public:
 
 		handleInput();
 
-		// Draw points
+		// The streamed hull is of the points in a file, which are not drawn
+		if (_showStreamedHull)
+		{
+			drawStreamedHull();
+			return true;
+		}
+
+		// The 3D view has its own points, hull and drawing
+		if (_view3D)
+		{
+			updateView3D(fElapsedTime);
+			return true;
+		}
+
+		// The kinetic mode moves the points and keeps the hull up to date before they are drawn
+		if (_kineticMode && _hullRunning == false)
+			updateKinetic(fElapsedTime);
+
+		// Draw points, all of them in one call and then the hull points over them
+		DrawPoints(_hullPoints._x.data(), _hullPoints._y.data(), _hullPoints.size(), olc::CYAN, _scaleFactor, _pointOffset);
 		for (auto& point : _points)
-			point.drawSelf(this, _scaleFactor, _pointOffset);
+		{
+			if (point.isOnHull())
+				point.drawSelf(this, _scaleFactor, _pointOffset);
+		}
 
 		// Draw lines
 		for (auto& line : _lines)
 			line.drawSelf(this, _scaleFactor, _pointOffset);
+		if (_showQueries && _simulationComplete)
+			drawQueries();
 
 
 		// Computation execution here
 		if (_simulationComplete == false)
 		{
-			auto timeStart = std::chrono::steady_clock::now();
-			_simulationComplete = QuickHull(_points, _lines);
-			std::chrono::duration<float> timeTaken = std::chrono::steady_clock::now() - timeStart;
-
-			_quickHullRunTimes.push_back(timeTaken.count() * 1000.0f);
-
-			// Get the average
-			float averageTime = _quickHullRunTimes[0];
-			for (size_t i = 1; i < _quickHullRunTimes.size(); i++)
+			// The structure-of-arrays engines run on the worker, the original QuickHull
+			// changes the render points and lines as it goes, so it runs here
+			if (_hullEngine)
+				updateHullRun();
+			else
 			{
-				averageTime += _quickHullRunTimes[i];
+				size_t allocationsAtStart = AllocationCounter::getCount();
+				auto timeStart = std::chrono::steady_clock::now();
+				_hullProfiler.clear();
+				_simulationComplete = QuickHull(_points, _lines, _hullOrder);
+				std::chrono::duration<float> timeTaken = std::chrono::steady_clock::now() - timeStart;
+				printRunTime(timeTaken.count() * 1000.0f, AllocationCounter::getCount() - allocationsAtStart);
 			}
-			averageTime /= float(_quickHullRunTimes.size());
-
-			// Display
-			std::cout << "Time to QuickHull " << _pointCount << " points (milliseconds): " << _quickHullRunTimes.back() << " avg: " << averageTime << std::endl;
 		}
+		if (_showProfile && _simulationComplete)
+			drawProfile();
 
 		return true;
 	}
 
-	void placePointsUniformly()
+	void printRunTime(float runTime, size_t allocations)
 	{
-		for (auto& point : _points)
+		// Get the average
+		_quickHullRunTimeTotal += runTime;
+		_quickHullRunCount++;
+		float averageTime = _quickHullRunTimeTotal / float(_quickHullRunCount);
+
+		// Display
+		std::cout << "Time to " << getEngineName() << " " << _pointCount << " points (milliseconds): " << runTime << " avg: " << averageTime
+			<< " allocations: " << allocations;
+		if (_hullEngine == &_quickHullSoA && _quickHullSoA.isCulling())
+			std::cout << " points left after culling: " << _quickHullSoA.getCandidateCount();
+		if (_hullEngine == &_quickHullSoA && _approximateMode != ApproximateMode::Off)
+			std::cout << " approximation error (pixels): " << _quickHullSoA.getApproximationError() * _scaleFactor;
+		std::cout << std::endl;
+		printHullStats();
+	}
+
+	// #######################################################################################################
+	// Hull worker
+	// #######################################################################################################
+
+	// Starts the engine on the worker, then draws the hull edges it has finished every frame until it is done
+	void updateHullRun()
+	{
+		if (_hullRunning == false)
+		{
+			_progressEdges.clear();
+			_hullProfiler.clear();
+			_runAllocationsAtStart = AllocationCounter::getCount();
+			_hullWorker.start(*_hullEngine, _hullPoints, _debugDisplay);
+			_hullRunning = true;
+		}
+
+		_hullWorker.drainProgress(_progressEdges);
+		if (_hullWorker.isRunning())
+		{
+			for (auto& edge : _progressEdges)
+				DrawLine(olc::vf2d(_hullPoints._x[edge._a], _hullPoints._y[edge._a]) * _scaleFactor + _pointOffset,
+					olc::vf2d(_hullPoints._x[edge._b], _hullPoints._y[edge._b]) * _scaleFactor + _pointOffset, olc::RED);
+			return;
+		}
+
+		// Every buffer is kept between runs, so re-running on the same points should not allocate
+		// The count is over the whole run, so it includes what the render thread allocated meanwhile
+		size_t allocations = AllocationCounter::getCount() - _runAllocationsAtStart;
+		_hullWorker.takeResults(_hullEdges, _debugEdges);
+		_hullRunning = false;
+		_progressEdges.clear();
+		_simulationComplete = true;
+		updatePointsFromHullPoints();
+		printRunTime(_hullWorker.getRunTime(), allocations);
+	}
+	// The worker uses _hullPoints and the engine, so anything that changes them waits for it first
+	// The run is dropped and a new one starts once the change is made
+	void waitForHullRun()
+	{
+		if (_hullRunning == false)
+			return;
+		_hullWorker.wait();
+		_hullRunning = false;
+		_progressEdges.clear();
+	}
+
+	// Places the points of the dataset for _seed, the worst case puts them all on a circle
+	void placePoints()
+	{
+		auto timeStart = std::chrono::steady_clock::now();
+		if (_view3D)
 		{
-			point._position = olc::vf2d(_uniDistX(_r), _uniDistY(_r));
+			_hullPoints3D.resize(_pointCount);
+			PointDatasets::generate(getDataset(), _hullPoints3D, _seed);
 		}
+		else
+			PointDatasets::generate(getDataset(), _hullPoints, _seed);
+		std::chrono::duration<float> timeTaken = std::chrono::steady_clock::now() - timeStart;
+		copyHullPointsToPoints();
+		if (_view3D == false)
+			_pointGrid.build(_hullPoints);
+
+		std::cout << "Placed " << _pointCount << (_view3D ? " 3D " : " ") << PointDatasets::getName(getDataset()) << " points with seed " << _seed
+			<< " (milliseconds): " << timeTaken.count() * 1000.0f << std::endl;
+	}
+	PointDatasets::Dataset getDataset() const
+	{
+		return _worstCaseEnabled ? PointDatasets::Dataset::OnCircle : _dataset;
 	}
-	void placePointsUniformlyOnCircle()
+	// Adds points of the same dataset to the current ones. The dynamic hull takes them in one at a time,
+	// the other engines run again on all of the points
+	void addPoints(size_t count)
 	{
-		float radiansOfChange = 360.0f / float(_points.size()) * 0.01745329f;
+		waitForHullRun();
+		if (_view3D)
+		{
+			size_t start = _hullPoints3D.size();
+			_hullPoints3D.resize(start + count);
+			PointDatasets::generate(getDataset(), _hullPoints3D, _seed, start);
+			_pointCount = int(_hullPoints3D.size());
+			_simulationComplete = false;
+			return;
+		}
 
+		// The lines point at the points, which can move when the vector grows
+		_lines.clear();
+
+		size_t start = _hullPoints.size();
+		_points.resize(start + count);
+		_hullPoints.resize(start + count);
+		PointDatasets::generate(getDataset(), _hullPoints, _seed, start);
+		for (size_t i = start; i < _hullPoints.size(); i++)
+			_points[i]._position = olc::vf2d(_hullPoints._x[i], _hullPoints._y[i]);
+		_pointCount = int(_points.size());
+		resetPointColors();
+		_pointGrid.update(_hullPoints);
+		_selectedPoints.clear();
+
+		if (_hullEngine != &_dynamicHull)
+		{
+			_simulationComplete = false;
+			return;
+		}
+
+		auto timeStart = std::chrono::steady_clock::now();
+		size_t addedToHull = 0;
+		for (size_t i = start; i < _hullPoints.size(); i++)
+			addedToHull += _dynamicHull.insert(_hullPoints._x[i], _hullPoints._y[i], uint32_t(i)) ? 1 : 0;
+		std::chrono::duration<float> timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+		_dynamicHull.getHull(_hullPoints, _hullEdges);
+		updatePointsFromHullPoints();
+		std::cout << "Time to insert " << count << " points into " << _dynamicHull.getName() << " (milliseconds): " << timeTaken.count() * 1000.0f
+			<< " added to hull: " << addedToHull << " point count: " << _pointCount << std::endl;
+		printHullStats();
+	}
+	// The hull engine works on _hullPoints, these keep the render side points in step with it
+	void copyHullPointsToPoints()
+	{
 		for (size_t i = 0; i < _points.size(); i++)
 		{
-			_points[i]._position.x = cosf(radiansOfChange * float(i)) * 0.5f + 0.5f;
-			_points[i]._position.y = sinf(radiansOfChange * float(i)) * 0.5f + 0.5f;
+			_points[i]._position = olc::vf2d(_hullPoints._x[i], _hullPoints._y[i]);
 		}
 	}
+	void updatePointsFromHullPoints()
+	{
+		for (size_t i = 0; i < _points.size(); i++)
+		{
+			if (_hullPoints.isOnHull(i))
+				_points[i].setAsOnHull();
+		}
+
+		if (_debugDisplay)
+		{
+			// For QuickHull the first debug edge is the line that splits all the points
+			bool firstIsSplit = _hullEngine == &_quickHullSoA;
+			for (size_t i = 0; i < _debugEdges.size(); i++)
+				_lines.push_back(Line(_points[_debugEdges[i]._a], _points[_debugEdges[i]._b], (firstIsSplit && i == 0) ? olc::GREEN : olc::RED));
+		}
+		if (_showFinalHull)
+		{
+			for (auto& edge : _hullEdges)
+				_lines.push_back(Line(_points[edge._a], _points[edge._b]));
+		}
+		_hullEdges.clear();
+		_debugEdges.clear();
+	}
+	// The last hull as indices into the points, counter clockwise
+	const std::vector<uint32_t>& getHullOrder() const
+	{
+		if (_kineticMode)
+			return _kineticHull.getHullOrder();
+		return _hullEngine ? _hullEngine->getHullOrder() : _hullOrder;
+	}
+	void printHullStats()
+	{
+		const std::vector<uint32_t>& hull = getHullOrder();
+		std::cout << "Hull points: " << hull.size() << " area: " << HullPolygon::area(_hullPoints, hull)
+			<< " perimeter: " << HullPolygon::perimeter(_hullPoints, hull) << std::endl;
+	}
+	std::string getEngineName() const
+	{
+		return _hullEngine ? _hullEngine->getName() : "QuickHull";
+	}
+	// nullptr selects the original QuickHull on the render points
+	void selectEngine(HullEngine* engine)
+	{
+		waitForHullRun();
+		_hullEngine = engine;
+		std::cout << "Hull engine: " << getEngineName() << std::endl;
+		clearRunTimes();
+	}
+	void clearRunTimes()
+	{
+		_quickHullRunTimeTotal = 0.0f;
+		_quickHullRunCount = 0;
+	}
+
 	void resetPointColors()
 	{
 		for (auto& point : _points)
@@ -151,10 +373,32 @@ public:
 	{
 		std::cout << 
 			"Point count: " << _points.size() << "\n"
+			"Hull kernels: " << HullKernels::getName() << "\n"
 			"Press R key to restart simulation\n"
 			"Press D key to toggle debug lines\n"
 			"Press S key to toggle showing the final hull\n"
 			"Press W key to toggle worst case performance for QuickHull\n"
+			"Press G key to go to the next dataset\n"
+			"Press F1 key for the original QuickHull engine\n"
+			"Press F2 key for the structure-of-arrays QuickHull engine\n"
+			"Press F3 key for the monotone chain engine\n"
+			"Press F4 key for Chan's algorithm engine\n"
+			"Press F5 key for the dynamic hull engine\n"
+			"Press F6 key for QuickHull on a 32 bit integer grid\n"
+			"Press F7 key for QuickHull on a 16 bit integer grid\n"
+			"Press T key to show the time of each phase of a run\n"
+			"Press J key to save the times of the last run as a Chrome trace (" << _traceFileName << ")\n"
+			"Press A key to add 1% more points, the dynamic hull adds them without starting over\n"
+			"Press P key to toggle the parallel QuickHull mode\n"
+			"Press C key to toggle culling the points inside the extremes before QuickHull\n"
+			"Press K key to toggle moving the points every frame with the hull kept up to date from the last one\n"
+			"Press E key to go through the approximate hull modes of the structure-of-arrays QuickHull: exact, within a pixel, at most " << _approximateVertexCount << " points\n"
+			"Press V key to switch between the 2D view and the 3D view, which runs QuickHull3D\n"
+			"Hold the left or right arrow key to turn the 3D view\n"
+			"Press O key to run the out of core hull on the point file, " << (_pointFileName.empty() ? "the current points are written to " + _defaultPointFileName : _pointFileName) << ", R goes back\n"
+			"Click the left mouse button to check if that spot is inside the hull\n"
+			"Press Q key to show the grid queries: the hull point nearest the mouse and the points near the hull edges\n"
+			"Drag with the right mouse button to select the points in a rectangle while the grid queries are shown\n"
 			"Press 1 for 10 points\n"
 			"Press 2 for 100 points\n"
 			"Press 3 for 1,000 points\n"
@@ -186,6 +430,12 @@ public:
 			else
 				std::cout << "Show final hull turned off" << std::endl;
 		}
+		if (GetKey(olc::G).bPressed)
+		{
+			_dataset = PointDatasets::Dataset((int(_dataset) + 1) % int(PointDatasets::Dataset::Count));
+			std::cout << "Dataset: " << PointDatasets::getName(_dataset) << std::endl;
+			resetSimulation = true;
+		}
 		if (GetKey(olc::W).bPressed)
 		{
 			_worstCaseEnabled = !_worstCaseEnabled;
@@ -195,8 +445,163 @@ public:
 				std::cout << "Worst case diabled" << std::endl;
 		}
 
+		// Hull engine selection
+		if (GetKey(olc::F1).bPressed)
+		{
+			selectEngine(nullptr);
+			resetSimulation = true;
+		}
+		if (GetKey(olc::F2).bPressed)
+		{
+			selectEngine(&_quickHullSoA);
+			resetSimulation = true;
+		}
+		if (GetKey(olc::F3).bPressed)
+		{
+			selectEngine(&_monotoneChainHull);
+			resetSimulation = true;
+		}
+		if (GetKey(olc::F4).bPressed)
+		{
+			selectEngine(&_chanHull);
+			resetSimulation = true;
+		}
+		if (GetKey(olc::F5).bPressed)
+		{
+			selectEngine(&_dynamicHull);
+			resetSimulation = true;
+		}
+		if (GetKey(olc::F6).bPressed)
+		{
+			selectEngine(&_quickHullInt32);
+			resetSimulation = true;
+		}
+		if (GetKey(olc::F7).bPressed)
+		{
+			selectEngine(&_quickHullInt16);
+			resetSimulation = true;
+		}
+		if (GetKey(olc::A).bPressed)
+			addPoints(std::max(size_t(1), size_t(_pointCount) / 100));
+
+		// Hull queries
+		if (GetMouse(0).bPressed && _simulationComplete && _view3D == false)
+		{
+			olc::vf2d position = (olc::vf2d(GetMousePos()) - _pointOffset) / _scaleFactor;
+			bool inside = HullPolygon::contains(_hullPoints, getHullOrder(), position.x, position.y);
+			std::cout << "(" << position.x << ", " << position.y << ") is " << (inside ? "inside" : "outside") << " the hull" << std::endl;
+		}
+		if (GetKey(olc::Q).bPressed)
+		{
+			_showQueries = !_showQueries;
+			if (_showQueries)
+				std::cout << "Grid queries on, " << _pointGrid.getColumns() << " by " << _pointGrid.getRows() << " cells" << std::endl;
+			else
+				std::cout << "Grid queries off" << std::endl;
+			_selecting = false;
+			_selectedPoints.clear();
+		}
+		if (_showQueries && _view3D == false)
+		{
+			olc::vf2d position = (olc::vf2d(GetMousePos()) - _pointOffset) / _scaleFactor;
+			if (GetMouse(1).bPressed)
+			{
+				_selecting = true;
+				_selectStart = position;
+			}
+			if (GetMouse(1).bReleased && _selecting)
+			{
+				_selecting = false;
+				_selectedPoints.clear();
+				auto timeStart = std::chrono::steady_clock::now();
+				_pointGrid.findInRect(_hullPoints, _selectStart.x, _selectStart.y, position.x, position.y, _selectedPoints);
+				std::chrono::duration<float> timeTaken = std::chrono::steady_clock::now() - timeStart;
+				std::cout << "Points in the rectangle: " << _selectedPoints.size() << " found in (milliseconds): " << timeTaken.count() * 1000.0f << std::endl;
+			}
+		}
+		if (GetKey(olc::P).bPressed)
+		{
+			waitForHullRun();
+			_quickHullSoA.setParallel(!_quickHullSoA.isParallel());
+			if (_quickHullSoA.isParallel())
+				std::cout << "Parallel hull mode enabled (" << TaskPool::getInstance().getThreadCount() << " threads)" << std::endl;
+			else
+				std::cout << "Parallel hull mode disabled" << std::endl;
+			clearRunTimes();
+			resetSimulation = true;
+		}
+		if (GetKey(olc::C).bPressed)
+		{
+			waitForHullRun();
+			_quickHullSoA.setCulling(!_quickHullSoA.isCulling());
+			if (_quickHullSoA.isCulling())
+				std::cout << "Culling enabled" << std::endl;
+			else
+				std::cout << "Culling disabled" << std::endl;
+			clearRunTimes();
+			resetSimulation = true;
+		}
+
+		if (GetKey(olc::E).bPressed)
+		{
+			waitForHullRun();
+			setApproximateMode(ApproximateMode((int(_approximateMode) + 1) % int(ApproximateMode::Count)));
+			clearRunTimes();
+			resetSimulation = true;
+		}
+
+		if (GetKey(olc::K).bPressed && _view3D == false)
+		{
+			waitForHullRun();
+			_kineticMode = !_kineticMode;
+			_kineticSeeded = false;
+			if (_kineticMode)
+				std::cout << "Kinetic mode on, the points drift at up to " << _driftSpeed * _scaleFactor << " pixels a second" << std::endl;
+			else
+			{
+				// The engine runs again on the points where they stopped
+				std::cout << "Kinetic mode off" << std::endl;
+				_lines.clear();
+				resetPointColors();
+				_simulationComplete = false;
+			}
+		}
+
+		if (GetKey(olc::O).bPressed && _view3D == false)
+			runStreamingHull();
+
+		// Profiling
+		if (GetKey(olc::T).bPressed)
+		{
+			waitForHullRun();
+			_showProfile = !_showProfile;
+			setProfiler(_showProfile ? &_hullProfiler : nullptr);
+			if (_showProfile)
+				std::cout << "Phase timers on" << std::endl;
+			else
+				std::cout << "Phase timers off" << std::endl;
+			resetSimulation = true;
+		}
+		if (GetKey(olc::J).bPressed && _hullRunning == false)
+		{
+			if (_hullProfiler.writeChromeTrace(_traceFileName))
+				std::cout << "Chrome trace written to " << _traceFileName << std::endl;
+			else
+				std::cout << "Could not write " << _traceFileName << std::endl;
+		}
+
 		// Point count changing
 		bool resetPointVector = false;
+		if (GetKey(olc::V).bPressed)
+		{
+			// The 2D points were not kept in step with the 3D ones, so both are sized again
+			_view3D = !_view3D;
+			if (_view3D)
+				std::cout << "3D view with " << _quickHull3D.getName() << std::endl;
+			else
+				std::cout << "2D view" << std::endl;
+			resetPointVector = true;
+		}
 		if (GetKey(olc::NP1).bReleased || GetKey(olc::K1).bReleased)
 		{
 			_pointCount = 10;
@@ -230,43 +635,437 @@ public:
 
 		if (resetPointVector)
 		{
-			_quickHullRunTimes.clear();
+			waitForHullRun();
+			clearRunTimes();
 			_lines.clear();
-			_points.clear();
-			_points = std::vector<Point>(_pointCount);
+			_points.assign(_pointCount, Point()); // Keeps the memory when going down in count
+			_hullPoints.resize(_pointCount);
 
 			std::cout << "Point count = " << _points.size() << std::endl;
 		}
 		if (resetSimulation || resetPointVector)
 		{
+			waitForHullRun();
+			_showStreamedHull = false;
 			_lines.clear();
-			if (_worstCaseEnabled)
-				placePointsUniformlyOnCircle();
-			else
-				placePointsUniformly();
+			_selectedPoints.clear();
+			// A new seed for every reset, the seed is printed so a set can be made again
+			_seed++;
+			placePoints();
 			resetPointColors();
 			_simulationComplete = false;
+			_kineticSeeded = false;
+		}
+	}
+
+
+	// The tolerance is a pixel at the zoom when the mode is picked
+	void setApproximateMode(ApproximateMode mode)
+	{
+		_approximateMode = mode;
+		_quickHullSoA.setTolerance(mode == ApproximateMode::Tolerance ? 1.0f / _scaleFactor : 0.0f);
+		_quickHullSoA.setMaxVertexCount(mode == ApproximateMode::VertexCount ? _approximateVertexCount : 0);
+		if (mode == ApproximateMode::Tolerance)
+			std::cout << "Approximate hull within a pixel" << std::endl;
+		else if (mode == ApproximateMode::VertexCount)
+			std::cout << "Approximate hull of at most " << _approximateVertexCount << " points" << std::endl;
+		else
+			std::cout << "Exact hull" << std::endl;
+	}
+
+	// #######################################################################################################
+	// Kinetic mode
+	// #######################################################################################################
+
+	// Moves every point along its velocity, turning back at the sides of the unit square, then brings
+	// the hull up to date from the last frame's. No point moves more than _driftSpeed a second
+	void updateKinetic(float elapsedTime)
+	{
+		if (_kineticSeeded == false || _velocityX.size() != _hullPoints.size())
+		{
+			setVelocities(_kineticSeeded ? _velocityX.size() : 0);
+			_lines.clear();
+			resetPointColors();
+			_hullEdges.clear();
+			_kineticHull.computeHull(_hullPoints, _hullEdges);
+			_kineticSeeded = true;
+			_kineticTimeTotal = 0.0f;
+			_kineticFrameCount = 0;
+			_kineticBuildCount = 0;
+		}
+
+		// A long frame, like the first one, would use up the band in one go
+		float step = std::min(elapsedTime, 0.05f);
+		for (size_t i = 0; i < _hullPoints.size(); i++)
+		{
+			float& x = _hullPoints._x[i];
+			float& y = _hullPoints._y[i];
+			x += _velocityX[i] * step;
+			y += _velocityY[i] * step;
+			if ((x < 0.0f && _velocityX[i] < 0.0f) || (x > 1.0f && _velocityX[i] > 0.0f))
+				_velocityX[i] = -_velocityX[i];
+			if ((y < 0.0f && _velocityY[i] < 0.0f) || (y > 1.0f && _velocityY[i] > 0.0f))
+				_velocityY[i] = -_velocityY[i];
+		}
+		copyHullPointsToPoints();
+		for (uint32_t index : _kineticHull.getHullOrder())
+			_points[index].resetColor();
+
+		if (_showProfile)
+			_hullProfiler.clear();
+		auto timeStart = std::chrono::steady_clock::now();
+		_hullEdges.clear();
+		bool seeded = _kineticHull.update(_hullPoints, _driftSpeed * step, _hullEdges);
+		std::chrono::duration<float> timeTaken = std::chrono::steady_clock::now() - timeStart;
+
+		_lines.clear();
+		updatePointsFromHullPoints();
+		_simulationComplete = true;
+		if (_showQueries)
+			_pointGrid.update(_hullPoints);
+
+		// Every second or so, so the console keeps up
+		_kineticTimeTotal += timeTaken.count() * 1000.0f;
+		_kineticFrameCount++;
+		_kineticBuildCount += seeded ? 0 : 1;
+		if (_kineticFrameCount == 60)
+		{
+			std::cout << "Kinetic hull of " << _hullPoints.size() << " points, average update (milliseconds): " << _kineticTimeTotal / float(_kineticFrameCount)
+				<< " full builds: " << _kineticBuildCount << " of " << _kineticFrameCount << " candidates: " << _kineticHull.getCandidateCount()
+				<< " hull points: " << _kineticHull.getHullOrder().size() << std::endl;
+			_kineticTimeTotal = 0.0f;
+			_kineticFrameCount = 0;
+			_kineticBuildCount = 0;
+		}
+	}
+	// Random directions and speeds up to _driftSpeed for the points from start, from the seed of the points
+	void setVelocities(size_t start)
+	{
+		_velocityX.resize(_hullPoints.size());
+		_velocityY.resize(_hullPoints.size());
+		for (size_t i = start; i < _hullPoints.size(); i++)
+		{
+			uint32_t random[4];
+			PhiloxRandom::generateBlock(_seed, _velocityStream, i, random);
+			float angle = float(random[0]) * (6.28318531f / 4294967296.0f);
+			float speed = float(random[1] >> 8) * (_driftSpeed / 16777216.0f);
+			_velocityX[i] = std::cos(angle) * speed;
+			_velocityY[i] = std::sin(angle) * speed;
+		}
+	}
+
+	// #######################################################################################################
+	// Grid queries
+	// #######################################################################################################
+
+	// The hull point nearest the mouse, the points within a few pixels of the hull edges and the
+	// selected points, all found with _pointGrid instead of looking through every point
+	void drawQueries()
+	{
+		const std::vector<uint32_t>& hull = getHullOrder();
+		_nearHullPoints.clear();
+		_pointGrid.findNearHull(_hullPoints, hull, _nearHullPixels / _scaleFactor, _nearHullPoints);
+		for (uint32_t index : _nearHullPoints)
+			Draw(getScreenPosition(index), olc::MAGENTA);
+
+		for (uint32_t index : _selectedPoints)
+			Draw(getScreenPosition(index), olc::YELLOW);
+		if (_selecting)
+		{
+			olc::vf2d start = _selectStart * _scaleFactor + _pointOffset;
+			olc::vf2d end = olc::vf2d(GetMousePos());
+			DrawRect(olc::vi2d(std::min(start.x, end.x), std::min(start.y, end.y)), olc::vi2d(std::fabs(end.x - start.x), std::fabs(end.y - start.y)), olc::YELLOW);
+		}
+
+		if (hull.empty() == false)
+		{
+			olc::vf2d position = (olc::vf2d(GetMousePos()) - _pointOffset) / _scaleFactor;
+			uint32_t nearest = _pointGrid.findNearest(_hullPoints, position.x, position.y, [this](uint32_t index) { return _points[index].isOnHull(); });
+			if (nearest != PointGrid::noPoint)
+				DrawCircle(getScreenPosition(nearest), 4, olc::YELLOW);
+		}
+	}
+	olc::vi2d getScreenPosition(uint32_t index) const
+	{
+		return olc::vi2d(olc::vf2d(_hullPoints._x[index], _hullPoints._y[index]) * _scaleFactor + _pointOffset);
+	}
+
+	// #######################################################################################################
+	// Profile overlay
+	// #######################################################################################################
+
+	// The original QuickHull runs here and reads the profiler through this, the other engines are given it
+	HullProfiler* getProfiler()
+	{
+		return _showProfile ? &_hullProfiler : nullptr;
+	}
+	void setProfiler(HullProfiler* profiler)
+	{
+		HullEngine* engines[] = { &_quickHullSoA, &_monotoneChainHull, &_chanHull, &_dynamicHull, &_quickHullInt32, &_quickHullInt16, &_kineticHull };
+		for (HullEngine* engine : engines)
+			engine->setProfiler(profiler);
+	}
+
+	// The phases of the last run as bars along its time, one row for each nesting depth like a flame
+	// graph, then a bar for the split time of each recursion depth and the counters under them
+	void drawProfile()
+	{
+		const std::vector<HullProfiler::Event>& events = _hullProfiler.getEvents();
+		if (events.empty())
+			return;
+		const int rowHeight = 10;
+		const float width = float(ScreenWidth() - 4);
+		const int64_t start = _hullProfiler.getStart();
+		const float runTime = float(std::max(int64_t(1), _hullProfiler.getEnd() - start));
+
+		uint32_t deepest = 0;
+		for (auto& event : events)
+		{
+			int x = 2 + int(float(event._start - start) / runTime * width);
+			int y = 2 + int(event._depth) * rowHeight;
+			int w = std::max(1, int(float(event._duration) / runTime * width));
+			FillRect(x, y, w, rowHeight - 1, getProfileColor(event._name));
+			// The name is cut to fit its bar, letters are 8 pixels wide
+			int letters = (w - 2) / 8;
+			if (letters > 0)
+				DrawString(x + 1, y + 1, event._name.substr(0, size_t(letters)), olc::BLACK);
+			deepest = std::max(deepest, event._depth);
+		}
+
+		// Each depth's bar is its share of the slowest depth
+		const std::vector<HullProfiler::Level>& levels = _hullProfiler.getLevels();
+		int64_t slowest = 1;
+		for (auto& level : levels)
+			slowest = std::max(slowest, level._splitNanoseconds + level._farthestNanoseconds);
+
+		char text[64];
+		int y = 2 + int(deepest + 1) * rowHeight + 4;
+		const int levelsEnd = ScreenHeight() - int(_hullProfiler.getCounters().size() + 2) * rowHeight;
+		for (size_t depth = 0; depth < levels.size(); depth++, y += rowHeight)
+		{
+			if (y + rowHeight > levelsEnd)
+			{
+				snprintf(text, sizeof(text), "%zu deeper levels", levels.size() - depth);
+				drawProfileText(y, text);
+				y += rowHeight;
+				break;
+			}
+			const HullProfiler::Level& level = levels[depth];
+			int64_t time = level._splitNanoseconds + level._farthestNanoseconds;
+			FillRect(2, y, std::max(1, int(float(time) / float(slowest) * width)), rowHeight - 1, olc::DARK_BLUE);
+			snprintf(text, sizeof(text), "d%zu %.3fms %zu pts", depth, double(time) / 1e6, level._pointsExamined);
+			DrawString(3, y + 1, text, olc::WHITE);
+		}
+
+		snprintf(text, sizeof(text), "recursion depth: %zu", levels.size());
+		drawProfileText(y, text);
+		y += rowHeight;
+		for (auto& counter : _hullProfiler.getCounters())
+		{
+			snprintf(text, sizeof(text), "%s: %llu", counter._name.c_str(), (unsigned long long)counter._value);
+			drawProfileText(y, text);
+			y += rowHeight;
+		}
+	}
+	void drawProfileText(int y, const std::string& text)
+	{
+		FillRect(2, y, int(text.size()) * 8 + 2, 9, olc::BLACK);
+		DrawString(3, y + 1, text, olc::WHITE);
+	}
+	// The same phase gets the same color in every run
+	static olc::Pixel getProfileColor(const std::string& name)
+	{
+		static const olc::Pixel colors[] = { olc::YELLOW, olc::GREEN, olc::CYAN, olc::MAGENTA, olc::RED, olc::WHITE, olc::GREY };
+		return colors[std::hash<std::string>()(name) % (sizeof(colors) / sizeof(colors[0]))];
+	}
+
+	// #######################################################################################################
+	// 3D view
+	// #######################################################################################################
+
+	// Runs QuickHull3D when the points have changed and draws the points and the hull turned to _viewAngle
+	void updateView3D(float fElapsedTime)
+	{
+		if (GetKey(olc::LEFT).bHeld)
+			_viewAngle -= fElapsedTime;
+		if (GetKey(olc::RIGHT).bHeld)
+			_viewAngle += fElapsedTime;
+
+		if (_simulationComplete == false)
+		{
+			size_t allocationsAtStart = AllocationCounter::getCount();
+			auto timeStart = std::chrono::steady_clock::now();
+			_hullEdges.clear();
+			_simulationComplete = _quickHull3D.computeHull(_hullPoints3D, _hullEdges);
+			std::chrono::duration<float> timeTaken = std::chrono::steady_clock::now() - timeStart;
+			size_t allocations = AllocationCounter::getCount() - allocationsAtStart;
+
+			float runTime = timeTaken.count() * 1000.0f;
+			_quickHullRunTimeTotal += runTime;
+			_quickHullRunCount++;
+			float averageTime = _quickHullRunTimeTotal / float(_quickHullRunCount);
+
+			size_t vertexCount = 0;
+			for (size_t i = 0; i < _hullPoints3D.size(); i++)
+				vertexCount += _hullPoints3D.isOnHull(i) ? 1 : 0;
+			std::cout << "Time to " << _quickHull3D.getName() << " " << _pointCount << " points (milliseconds): " << runTime << " avg: " << averageTime
+				<< " allocations: " << allocations << " points left after the first tetrahedron: " << _quickHull3D.getCandidateCount() << std::endl;
+			std::cout << "Hull vertices: " << vertexCount << " edges: " << _hullEdges.size() << " faces: " << _quickHull3D.getFaceCount() << std::endl;
+		}
+
+		projectPoints3D();
+		DrawPoints(_projectedX.data(), _projectedY.data(), _projectedX.size(), olc::CYAN, _scaleFactor, _pointOffset);
+		if (_showFinalHull)
+			drawHull3D();
+	}
+	// Turns the points about the upright axis through the middle of the cube, tips them toward the
+	// viewer and drops the depth. The results are around the middle of the unit square, so they
+	// are drawn with the same scale and offset as the 2D points
+	void projectPoints3D()
+	{
+		size_t n = _hullPoints3D.size();
+		_projectedX.resize(n);
+		_projectedY.resize(n);
+		float turnCos = cosf(_viewAngle), turnSin = sinf(_viewAngle);
+		float tipCos = cosf(_viewTip), tipSin = sinf(_viewTip);
+		for (size_t i = 0; i < n; i++)
+		{
+			float x = _hullPoints3D._x[i] - 0.5f;
+			float y = _hullPoints3D._y[i] - 0.5f;
+			float z = _hullPoints3D._z[i] - 0.5f;
+			float turnedX = turnCos * x + turnSin * z;
+			float turnedZ = turnCos * z - turnSin * x;
+			float tippedY = tipCos * y - tipSin * turnedZ;
+			// Screen y goes down
+			_projectedX[i] = 0.5f + turnedX * _viewScale3D;
+			_projectedY[i] = 0.5f - tippedY * _viewScale3D;
 		}
 	}
+	// The faces turned away from the viewer are drawn first and darker, so the front ones are on top
+	void drawHull3D()
+	{
+		const std::vector<uint32_t>& vertices = _quickHull3D.getFaceVertices();
+		const std::vector<uint32_t>& starts = _quickHull3D.getFaceStarts();
+		for (int pass = 0; pass < 2; pass++)
+		{
+			for (size_t face = 0; face < _quickHull3D.getFaceCount(); face++)
+			{
+				uint32_t start = starts[face];
+				uint32_t count = starts[face + 1] - start;
+				// Counter clockwise seen from outside, so facing the viewer when clockwise on the screen
+				uint32_t a = vertices[start], b = vertices[start + 1], c = vertices[start + 2];
+				bool front = HullPredicates::orientation(_projectedX[a], _projectedY[a], _projectedX[b], _projectedY[b], _projectedX[c], _projectedY[c]) < 0.0;
+				if (front != (pass == 1))
+					continue;
+				for (uint32_t i = 0; i < count; i++)
+				{
+					uint32_t from = vertices[start + i];
+					uint32_t to = vertices[start + (i + 1) % count];
+					DrawLine(olc::vf2d(_projectedX[from], _projectedY[from]) * _scaleFactor + _pointOffset,
+						olc::vf2d(_projectedX[to], _projectedY[to]) * _scaleFactor + _pointOffset, front ? olc::YELLOW : olc::DARK_YELLOW);
+				}
+			}
+		}
 
+		// Points all on one line have an edge and no faces
+		if (_quickHull3D.getFaceCount() == 0)
+		{
+			for (auto& edge : _hullEdges)
+				DrawLine(olc::vf2d(_projectedX[edge._a], _projectedY[edge._a]) * _scaleFactor + _pointOffset,
+					olc::vf2d(_projectedX[edge._b], _projectedY[edge._b]) * _scaleFactor + _pointOffset);
+		}
+	}
+
+	// #######################################################################################################
+	// Out of core hull
+	// #######################################################################################################
+
+	// Runs StreamingHull on the point file from the command line. Without one the current points
+	// are written to _defaultPointFileName first, so it can be tried on any dataset
+	void runStreamingHull()
+	{
+		std::string fileName = _pointFileName;
+		StreamingHull::Format format = _pointFileFormat;
+		if (fileName.empty())
+		{
+			fileName = _defaultPointFileName;
+			format = StreamingHull::Format::Float32;
+			if (StreamingHull::writePoints(fileName, _hullPoints, format) == false)
+			{
+				std::cout << "Could not write " << fileName << std::endl;
+				return;
+			}
+		}
+
+		auto timeStart = std::chrono::steady_clock::now();
+		bool read = _streamingHull.computeHull(fileName, format);
+		std::chrono::duration<float> timeTaken = std::chrono::steady_clock::now() - timeStart;
+		if (read == false)
+		{
+			std::cout << "Could not read " << fileName << ": " << _streamingHull.getError() << std::endl;
+			return;
+		}
+
+		std::cout << "Time to stream the hull of " << _streamingHull.getPointCount() << " points from " << fileName << " in " << _streamingHull.getChunkCount()
+			<< " chunks (milliseconds): " << timeTaken.count() * 1000.0f << " chunk hull points: " << _streamingHull.getCandidateCount()
+			<< " hull points: " << _streamingHull.getHull().size() << std::endl;
+		_showStreamedHull = true;
+	}
+	// The file's points can be anywhere, so the hull is fitted to the window
+	void drawStreamedHull()
+	{
+		const HullPoints& hull = _streamingHull.getHull();
+		if (hull.size() == 0)
+			return;
+
+		float minX = hull._x[0], maxX = hull._x[0];
+		float minY = hull._y[0], maxY = hull._y[0];
+		for (size_t i = 1; i < hull.size(); i++)
+		{
+			minX = std::min(minX, hull._x[i]);
+			maxX = std::max(maxX, hull._x[i]);
+			minY = std::min(minY, hull._y[i]);
+			maxY = std::max(maxY, hull._y[i]);
+		}
+		float size = std::max(maxX - minX, maxY - minY);
+		float scale = 0.9f * float(std::min(ScreenWidth(), ScreenHeight())) / (size > 0.0f ? size : 1.0f);
+		olc::vf2d middle = { (minX + maxX) * 0.5f, (minY + maxY) * 0.5f };
+		olc::vf2d screenMiddle = olc::vf2d(GetScreenSize()) * 0.5f;
+
+		for (size_t i = 0; i < hull.size(); i++)
+		{
+			size_t next = (i + 1) % hull.size();
+			DrawLine((olc::vf2d(hull._x[i], hull._y[i]) - middle) * scale + screenMiddle,
+				(olc::vf2d(hull._x[next], hull._y[next]) - middle) * scale + screenMiddle, olc::YELLOW);
+		}
+	}
 
 	// #######################################################################################################
 	// QuickHull algorithm - see Point and Line at the top of QuickHullSim class definition
 	// #######################################################################################################
 	
 	// Returns true on complete
-	bool QuickHull(std::vector<Point>& points, std::vector<Line>& lines)
+	// The hull is put in hullOrder as indices into points in counter clockwise order
+	// starting at the leftmost point. Every split writes its new hull point into a slot
+	// of _hullSlots between the slots of its two sides, so no sorting is needed
+	bool QuickHull(std::vector<Point>& points, std::vector<Line>& lines, std::vector<uint32_t>& hullOrder)
 	{
+		HullProfiler* profiler = getProfiler();
+		HullProfiler::Scope runScope(profiler, "QuickHull");
+
 		// Greatest x value
 		Point* B = &points.front();
 		// Least x Value
 		Point* A = &points.front();
-		for (size_t i = 1; i < points.size(); i++)
 		{
-			if (points[i]._position.x < A->_position.x)
-				A = &points[i]; // Set min point
-			if (points[i]._position.x > B->_position.x)
-				B = &points[i]; // Set max point
+			HullProfiler::Scope scope(profiler, "min/max scan");
+			for (size_t i = 1; i < points.size(); i++)
+			{
+				if (points[i]._position.x < A->_position.x)
+					A = &points[i]; // Set min point
+				if (points[i]._position.x > B->_position.x)
+					B = &points[i]; // Set max point
+			}
 		}
 
 		A->setAsOnHull();
@@ -275,64 +1074,140 @@ public:
 		if(_debugDisplay)
 			lines.push_back(Line(*A, *B, olc::GREEN));
 
-		// 2n additional pointer memory
-		std::vector<Point*> pointsSource(points.size());
-		std::vector<Point*> pointsDestination(points.size());
+		// 2n additional pointer memory, kept between runs
+		// Every slot starts as nullptr, splitPoints relies on that for empty ranges
+		std::vector<Point*>& pointsSource = _pointsSource;
+		std::vector<Point*>& pointsDestination = _pointsDestination;
+		pointsSource.assign(points.size(), nullptr);
+		pointsDestination.assign(points.size(), nullptr);
 
 		// Split
 		int lastAboveIndex = 0;
 		int firstBelowIndex = 0;
-		splitAllPoints(A, B, points, pointsSource, lastAboveIndex, firstBelowIndex);
+		int64_t splitStart = profiler ? HullProfiler::now() : 0;
+		{
+			HullProfiler::Scope scope(profiler, "splitAllPoints");
+			splitAllPoints(A, B, points, pointsSource, lastAboveIndex, firstBelowIndex);
+		}
+		int64_t splitEnd = profiler ? HullProfiler::now() : 0;
+
+		// A, the top chain, B, then the bottom chain
+		int topCount = pointsSource.front() ? lastAboveIndex + 1 : 0;
+		int bottomCount = pointsSource.back() ? int(points.size()) - firstBelowIndex : 0;
+		if (profiler)
+		{
+			profiler->addSplit(0, points.size(), size_t(topCount), size_t(bottomCount), splitEnd - splitStart);
+			profiler->addCount("points", points.size());
+		}
+		int slotCount = topCount + bottomCount + 2;
+		_hullSlots.assign(slotCount, nullptr);
+		_hullSlots[0] = A;
+		_hullSlots[topCount + 1] = B;
 
 		// Begin recurse
-		QuickHullSub(A, B, pointsSource, 0, lastAboveIndex, pointsDestination); // Top
-		QuickHullSub(B, A, pointsSource, firstBelowIndex, points.size() - 1, pointsDestination); // Bottom
+		QuickHullSub(A, B, pointsSource, 0, lastAboveIndex, pointsDestination, 1); // Top
+		QuickHullSub(B, A, pointsSource, firstBelowIndex, points.size() - 1, pointsDestination, topCount + 2); // Bottom
+
+		hullOrder.clear();
+		for (int i = 0; i < slotCount; i++)
+		{
+			if (_hullSlots[i])
+				hullOrder.push_back(uint32_t(_hullSlots[i] - points.data()));
+		}
+		if (_showFinalHull)
+		{
+			for (size_t i = 0; i < hullOrder.size(); i++)
+				lines.push_back(Line(points[hullOrder[i]], points[hullOrder[(i + 1) % hullOrder.size()]]));
+		}
 
 		return true;
 	}
-	void QuickHullSub(Point* A, Point* B, std::vector<Point*>& pointsSource, const int rangeStart, const int rangeEnd, std::vector<Point*>& pointsDestination, int depthCount = 0)
+	// A range still to be split, its points are in pointsSource and are above A-B
+	struct QuickHullFrame
 	{
-		depthCount++;
-		// These pointers are set in the splitPoints function when no points are copied over
-		if (pointsSource[rangeStart] == nullptr || pointsSource[rangeEnd] == nullptr)
+		Point* _A;
+		Point* _B;
+		std::vector<Point*>* _pointsSource;
+		std::vector<Point*>* _pointsDestination;
+		int _rangeStart;
+		int _rangeEnd;
+		int _outputStart; // First of the hull slots for the hull points between A and B, one for each point in the range
+		size_t _depth; // Splits since the first one, for the profiler
+	};
+	// The ranges are kept on a fixed size stack instead of recursing. The smaller side of
+	// each split is done next and the larger one waits, so the stack stays under log2(n)
+	// frames even when every point is on the hull
+	void QuickHullSub(Point* A, Point* B, std::vector<Point*>& pointsSource, const int rangeStart, const int rangeEnd, std::vector<Point*>& pointsDestination, const int outputStart)
+	{
+		HullProfiler* profiler = getProfiler();
+		HullProfiler::Scope scope(profiler, "QuickHullSub");
+		QuickHullFrame stack[64];
+		int stackSize = 0;
+
+		QuickHullFrame frame = { A, B, &pointsSource, &pointsDestination, rangeStart, rangeEnd, outputStart, 1 };
+		while (true)
 		{
-			if(_showFinalHull)
-				_lines.push_back(Line(*A, *B));
-			return;
-		}
+			// These pointers are set in the splitPoints function when no points are copied over
+			std::vector<Point*>& source = *frame._pointsSource;
+			if (source[frame._rangeStart] == nullptr || source[frame._rangeEnd] == nullptr)
+			{
+				if (stackSize == 0)
+					return;
+				frame = stack[--stackSize];
+				continue;
+			}
 
-		Point* C = getFarthestPointFromAB(A, B, pointsSource, rangeStart, rangeEnd);
-		C->setAsOnHull();
+			int64_t farthestStart = profiler ? HullProfiler::now() : 0;
+			Point* C = getFarthestPointFromAB(frame._A, frame._B, source, frame._rangeStart, frame._rangeEnd);
+			C->setAsOnHull();
 
-		if (_debugDisplay)
-		{
-			_lines.push_back(Line(*A, *C, olc::RED));
-			_lines.push_back(Line(*B, *C, olc::RED));
-		}
-		
-		// Divide
-		int lastACIndex = 0;
-		int firstCBIndex = 0;
-		splitPoints(A, B, C, pointsSource, rangeStart, rangeEnd, pointsDestination, lastACIndex, firstCBIndex);
+			if (_debugDisplay)
+			{
+				_lines.push_back(Line(*frame._A, *C, olc::RED));
+				_lines.push_back(Line(*frame._B, *C, olc::RED));
+			}
+
+			// Divide
+			int lastACIndex = 0;
+			int firstCBIndex = 0;
+			int64_t splitStart = profiler ? HullProfiler::now() : 0;
+			splitPoints(frame._A, frame._B, C, source, frame._rangeStart, frame._rangeEnd, *frame._pointsDestination, lastACIndex, firstCBIndex);
+			int64_t splitEnd = profiler ? HullProfiler::now() : 0;
 
-		// Recurse
-		QuickHullSub(A, C, pointsDestination, rangeStart, lastACIndex, pointsSource, depthCount); // Left
-		QuickHullSub(C, B, pointsDestination, firstCBIndex, rangeEnd, pointsSource, depthCount); // Right
+			// C goes after the slots of the A-C side, C is on neither side so they all fit in this range's slots
+			std::vector<Point*>& destination = *frame._pointsDestination;
+			int leftCount = destination[frame._rangeStart] ? lastACIndex - frame._rangeStart + 1 : 0;
+			_hullSlots[frame._outputStart + leftCount] = C;
+			if (profiler)
+			{
+				int rightCount = destination[frame._rangeEnd] ? frame._rangeEnd - firstCBIndex + 1 : 0;
+				profiler->addSplit(frame._depth, size_t(frame._rangeEnd - frame._rangeStart + 1), size_t(leftCount), size_t(rightCount),
+					splitEnd - splitStart, splitStart - farthestStart);
+			}
+
+			// The new ranges are in the destination, which is the source for the next split
+			QuickHullFrame left = { frame._A, C, frame._pointsDestination, frame._pointsSource, frame._rangeStart, lastACIndex, frame._outputStart, frame._depth + 1 };
+			QuickHullFrame right = { C, frame._B, frame._pointsDestination, frame._pointsSource, firstCBIndex, frame._rangeEnd, frame._outputStart + leftCount + 1, frame._depth + 1 };
+			if (left._rangeEnd - left._rangeStart > right._rangeEnd - right._rangeStart)
+				std::swap(left, right);
+			stack[stackSize++] = right;
+			frame = left;
+		}
 	}
 
+	// Above is clockwise of A to B. The float perp().dot() got the sign wrong for points
+	// almost on the line, so the exact orientation test is used
 	bool isAboveline(const Point* A, const Point* B, const Point* point)
 	{
-		olc::vf2d lineVector = B->_position - A->_position;
-		olc::vf2d lineStartToPointVector = point->_position - A->_position;
-
-		if (lineVector.perp().dot(lineStartToPointVector) < 0.0f)
+		if (HullPredicates::orientation(A->_position.x, A->_position.y, B->_position.x, B->_position.y, point->_position.x, point->_position.y) < 0.0)
 			return true;
 		return false;
 	}
+	// Distance scaled by the length of the line, sqrtf(a * a + b * b) is the same for
+	// every point so it is left out when only looking for the farthest point
 	float distFromLine(float a, float b, float c, const Point* point)
 	{
-		return abs(a * point->_position.x + b * point->_position.y + c) /
-			sqrtf(a * a + b * b);
+		return abs(a * point->_position.x + b * point->_position.y + c);
 	}
 	// Returns the split point (index of the last element of the )
 	void splitPoints(Point* A, Point* B, Point* C, const std::vector<Point*>& pointsSource, const int rangeStart, const int rangeEnd, std::vector<Point*>& pointsDestination, int& lastACIndex, int& firstCBIndex)
@@ -353,7 +1228,9 @@ public:
 				lastACIndex++;
 				correctLastACIndex = true;
 			}
-			if (isAboveline(C, B, pointsSource[i]))
+			// C is picked by a rounded distance, so a point can be above both lines when it is
+			// nearly as far out. Writing it to both sides would run the two ranges into each other
+			else if (isAboveline(C, B, pointsSource[i]))
 			{
 				pointsDestination[firstCBIndex] = pointsSource[i];
 				firstCBIndex--;
@@ -437,14 +1314,87 @@ public:
 public:
 	// The number of points to use
 	int _pointCount = 10;
-	std::vector<float> _quickHullRunTimes;
+	float _quickHullRunTimeTotal = 0.0f;
+	int _quickHullRunCount = 0;
 	std::vector<Point> _points;
 	std::vector<Line> _lines;
+	std::vector<uint32_t> _hullOrder; // Hull from the original QuickHull, counter clockwise
+
+	// Working memory of the original QuickHull, sized by the first run on a point count
+	// and reused after that
+	std::vector<Point*> _pointsSource;
+	std::vector<Point*> _pointsDestination;
+	std::vector<Point*> _hullSlots; // Hull points in order with gaps between them
+
+	// Structure-of-arrays hull engines and their outputs
+	HullPoints _hullPoints;
+	QuickHullSoA _quickHullSoA;
+	MonotoneChainHull _monotoneChainHull;
+	ChanHull _chanHull;
+	DynamicHull _dynamicHull;
+	IntegerQuickHull<int32_t> _quickHullInt32;
+	IntegerQuickHull<int16_t> _quickHullInt16;
+	HullEngine* _hullEngine = &_quickHullSoA; // nullptr runs the original QuickHull
+	std::vector<HullEdge> _hullEdges;
+	std::vector<HullEdge> _debugEdges;
+
+	// Kinetic mode, the points drift and the hull is kept up to date instead of run again
+	KineticHull _kineticHull;
+	bool _kineticMode = false;
+	bool _kineticSeeded = false; // The velocities and the first hull are made for the points in place
+	std::vector<float> _velocityX;
+	std::vector<float> _velocityY;
+	float _driftSpeed = 0.02f; // Unit square sizes a second
+	uint32_t _velocityStream = 8; // Stream of the point seed the velocities come from, past the ones the datasets use
+	float _kineticTimeTotal = 0.0f;
+	size_t _kineticFrameCount = 0;
+	size_t _kineticBuildCount = 0;
+
+	// Approximate hulls of the structure-of-arrays QuickHull
+	ApproximateMode _approximateMode = ApproximateMode::Off;
+	size_t _approximateVertexCount = 256;
+
+	// Runs the engines off the render thread, declared after the points and engines so it stops before they go
+	HullWorker _hullWorker;
+	bool _hullRunning = false;
+	std::vector<HullEdge> _progressEdges; // Hull edges the run in progress has finished so far
+	size_t _runAllocationsAtStart = 0;
+
+	// Phase timers, only given to the engines while the overlay is shown
+	HullProfiler _hullProfiler;
+	bool _showProfile = false;
+	std::string _traceFileName = "QuickHullSim.trace.json";
+
+	// Grid over _hullPoints for the mouse queries, built when the points are placed
+	PointGrid _pointGrid;
+	bool _showQueries = false;
+	bool _selecting = false;
+	olc::vf2d _selectStart = { 0.0f, 0.0f };
+	std::vector<uint32_t> _selectedPoints;
+	std::vector<uint32_t> _nearHullPoints;
+	float _nearHullPixels = 3.0f;
 
 	// Display scaling
 	float _scaleFactor = 250.0f;
 	olc::vf2d _pointOffset = { 0.0f, 0.0f };
 
+	// 3D view, the hull edges go in _hullEdges
+	bool _view3D = false;
+	HullPoints3D _hullPoints3D;
+	QuickHull3D _quickHull3D;
+	std::vector<float> _projectedX;
+	std::vector<float> _projectedY;
+	float _viewAngle = 0.6f; // Turn about the upright axis, in radians
+	float _viewTip = 0.4f; // Tip toward the viewer, in radians
+	float _viewScale3D = 0.55f; // The corners of the cube are sqrt(3) / 2 from its middle, this keeps them in the unit square
+
+	// Out of core hull, the file and format can be given on the command line
+	std::string _pointFileName;
+	StreamingHull::Format _pointFileFormat = StreamingHull::Format::Float32;
+	std::string _defaultPointFileName = "QuickHullSim.points";
+	StreamingHull _streamingHull;
+	bool _showStreamedHull = false;
+
 	bool _simulationComplete = false;
 	bool _debugDisplay = false;
 	bool _showFinalHull = true;
@@ -452,14 +1402,18 @@ public:
 	bool _worstCaseEnabled = false;
 
 	// Position resetting
-	std::random_device _r;
-	std::uniform_real_distribution<float> _uniDistX;
-	std::uniform_real_distribution<float> _uniDistY;
+	PointDatasets::Dataset _dataset = PointDatasets::Dataset::UniformSquare;
+	uint64_t _seed = 1;
 };
 
-int main()
+// Optional arguments: a point file for the out of core hull and its format, float (default) or double
+int main(int argc, char** argv)
 {
 	QuickHullSim quickHullSim;
+	if (argc > 1)
+		quickHullSim._pointFileName = argv[1];
+	if (argc > 2 && std::string(argv[2]) == "double")
+		quickHullSim._pointFileFormat = StreamingHull::Format::Float64;
 	if (quickHullSim.Construct(300, 300, 3, 3))
 		quickHullSim.Start();
 	return 0;
@@ -0,0 +1,158 @@
+// MappedFile.h
+// Nathan Damon
+// 2026-10-16
+// Read only memory mapping of a whole file
+//
+// The operating system reads the file's pages in as they are touched and
+// can drop them again when it needs the memory, so a file much larger
+// than memory can be read through as if it were one array. Uses mmap on
+// Linux and macOS and a file mapping on Windows.
+
+#pragma once
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+class MappedFile
+{
+public:
+	MappedFile() {}
+	~MappedFile()
+	{
+		close();
+	}
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// Returns false when the file could not be opened or mapped
+	// An empty file opens with no data
+	bool open(const std::string& fileName)
+	{
+		close();
+#if defined(_WIN32)
+		_file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (_file == INVALID_HANDLE_VALUE)
+			return false;
+		LARGE_INTEGER size;
+		if (GetFileSizeEx(_file, &size) == FALSE)
+		{
+			close();
+			return false;
+		}
+		_size = size_t(size.QuadPart);
+		if (_size == 0)
+			return true;
+
+		_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (_mapping == nullptr)
+		{
+			close();
+			return false;
+		}
+		_data = static_cast<const uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+		if (_data == nullptr)
+		{
+			close();
+			return false;
+		}
+#else
+		_file = ::open(fileName.c_str(), O_RDONLY);
+		if (_file < 0)
+			return false;
+		struct stat status;
+		if (fstat(_file, &status) != 0)
+		{
+			close();
+			return false;
+		}
+		_size = size_t(status.st_size);
+		if (_size == 0)
+			return true;
+
+		void* data = mmap(nullptr, _size, PROT_READ, MAP_SHARED, _file, 0);
+		if (data == MAP_FAILED)
+		{
+			close();
+			return false;
+		}
+		_data = static_cast<const uint8_t*>(data);
+		// The file is read front to back, so the pages ahead can be read early
+		madvise(data, _size, MADV_SEQUENTIAL);
+#endif
+		return true;
+	}
+
+	void close()
+	{
+#if defined(_WIN32)
+		if (_data)
+			UnmapViewOfFile(_data);
+		if (_mapping)
+			CloseHandle(_mapping);
+		if (_file != INVALID_HANDLE_VALUE)
+			CloseHandle(_file);
+		_mapping = nullptr;
+		_file = INVALID_HANDLE_VALUE;
+#else
+		if (_data)
+			munmap(const_cast<uint8_t*>(_data), _size);
+		if (_file >= 0)
+			::close(_file);
+		_file = -1;
+#endif
+		_data = nullptr;
+		_size = 0;
+	}
+
+	const uint8_t* getData() const
+	{
+		return _data;
+	}
+	size_t getSize() const
+	{
+		return _size;
+	}
+
+	// Tells the operating system a range that has been read will not be needed again, so reading
+	// through the file does not keep all of it in memory. Only the whole pages in the range are let go
+	void release(size_t offset, size_t size)
+	{
+#if defined(_WIN32)
+		// The pages of a read only view are dropped by Windows when it needs the memory
+		(void)offset;
+		(void)size;
+#else
+		size_t pageSize = size_t(sysconf(_SC_PAGESIZE));
+		size_t begin = (offset + pageSize - 1) / pageSize * pageSize;
+		size_t end = std::min(offset + size, _size) / pageSize * pageSize;
+		if (_data && begin < end)
+			madvise(const_cast<uint8_t*>(_data) + begin, end - begin, MADV_DONTNEED);
+#endif
+	}
+
+private:
+#if defined(_WIN32)
+	HANDLE _file = INVALID_HANDLE_VALUE;
+	HANDLE _mapping = nullptr;
+#else
+	int _file = -1;
+#endif
+	const uint8_t* _data = nullptr;
+	size_t _size = 0;
+};
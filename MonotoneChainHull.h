@@ -0,0 +1,216 @@
+// MonotoneChainHull.h
+// Nathan Damon
+// 2026-10-16
+// Andrew's monotone chain convex hull
+//
+// The points are sorted by x with a radix sort on the float bits (points
+// with the same x are then sorted by y), copied into x sorted arrays and
+// the lower and upper chains are walked over them. Only the turns that
+// go counter clockwise are kept, so points on a hull edge are not part of
+// the hull. The buffers are kept between runs.
+
+#pragma once
+#include "HullEngine.h"
+#include "HullPredicates.h"
+#include <algorithm>
+#include <cstring>
+
+class MonotoneChainHull : public HullEngine
+{
+public:
+	MonotoneChainHull() {}
+	~MonotoneChainHull() {}
+
+	std::string getName() const override
+	{
+		return "MonotoneChain";
+	}
+
+	bool computeHull(HullPoints& points, std::vector<HullEdge>& edges, std::vector<HullEdge>* debugEdges = nullptr) override
+	{
+		(void)debugEdges;
+		HullProfiler::Scope runScope(_profiler, "MonotoneChain");
+		points.clearOnHull();
+		_hullOrder.clear();
+		size_t n = points.size();
+		if (n == 0)
+			return true;
+
+		{
+			HullProfiler::Scope scope(_profiler, "sortByX");
+			sortByX(points);
+		}
+		_hull.resize(n + 1);
+		size_t hullCount = 0;
+		{
+			HullProfiler::Scope scope(_profiler, "chain");
+			hullCount = chain(_sortedX.data(), _sortedY.data(), n, _hull.data());
+		}
+
+		for (size_t i = 0; i < hullCount; i++)
+			_hullOrder.push_back(_sortedIndex[_hull[i]]);
+		addHullEdges(points, edges);
+		return true;
+	}
+
+	// Fills the sorted arrays with the points ordered by x, then y
+	void sortByX(const HullPoints& points)
+	{
+		size_t n = points.size();
+		_order.resize(n);
+		if (n < _radixSortThreshold)
+		{
+			// Clearing the radix counts would take longer than sorting a few points
+			for (size_t i = 0; i < n; i++)
+				_order[i] = uint32_t(i);
+			std::sort(_order.begin(), _order.end(), [&points](uint32_t a, uint32_t b)
+				{
+					return points._x[a] < points._x[b] || (points._x[a] == points._x[b] && points._y[a] < points._y[b]);
+				});
+			copySortedPoints(points);
+			return;
+		}
+
+		_keys.resize(n);
+		_keysTemp.resize(n);
+		_orderTemp.resize(n);
+
+		// Three passes of 11 bits, the counts for all of them are made in one read of the keys
+		constexpr size_t bucketCount = 1 << 11;
+		size_t counts[3][bucketCount] = {};
+		for (size_t i = 0; i < n; i++)
+		{
+			uint32_t key = getSortKey(points._x[i]);
+			_keys[i] = key;
+			_order[i] = uint32_t(i);
+			counts[0][key & 0x7FF]++;
+			counts[1][(key >> 11) & 0x7FF]++;
+			counts[2][key >> 22]++;
+		}
+
+		for (int pass = 0; pass < 3; pass++)
+		{
+			size_t offset = 0;
+			for (size_t bucket = 0; bucket < bucketCount; bucket++)
+			{
+				size_t count = counts[pass][bucket];
+				counts[pass][bucket] = offset;
+				offset += count;
+			}
+
+			int shift = pass * 11;
+			for (size_t i = 0; i < n; i++)
+			{
+				uint32_t key = _keys[i];
+				size_t position = counts[pass][(key >> shift) & 0x7FF]++;
+				_keysTemp[position] = key;
+				_orderTemp[position] = _order[i];
+			}
+			_keys.swap(_keysTemp);
+			_order.swap(_orderTemp);
+		}
+
+		// Points with the same x are put in y order
+		for (size_t start = 0; start < n;)
+		{
+			size_t end = start + 1;
+			while (end < n && _keys[end] == _keys[start])
+				end++;
+			if (end - start > 1)
+			{
+				std::sort(_order.begin() + start, _order.begin() + end,
+					[&points](uint32_t a, uint32_t b) { return points._y[a] < points._y[b]; });
+			}
+			start = end;
+		}
+		copySortedPoints(points);
+	}
+
+	const float* getSortedX() const { return _sortedX.data(); }
+	const float* getSortedY() const { return _sortedY.data(); }
+	const uint32_t* getSortedIndex() const { return _sortedIndex.data(); }
+
+	// Positive when O, A, B turn counter clockwise, the sign is exact
+	static double cross(float ox, float oy, float ax, float ay, float bx, float by)
+	{
+		return HullPredicates::orientation(ox, oy, ax, ay, bx, by);
+	}
+
+	// Hull of points already sorted by x, then y
+	// Writes the positions of the hull points into hull in counter clockwise order and returns how many there are
+	// hull needs room for count + 1 positions
+	static size_t chain(const float* x, const float* y, size_t count, uint32_t* hull)
+	{
+		if (count < 3)
+		{
+			for (size_t i = 0; i < count; i++)
+				hull[i] = uint32_t(i);
+			if (count == 2 && x[0] == x[1] && y[0] == y[1])
+				return 1;
+			return count;
+		}
+
+		// Lower chain from left to right
+		size_t k = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			while (k >= 2 && cross(x[hull[k - 2]], y[hull[k - 2]], x[hull[k - 1]], y[hull[k - 1]], x[i], y[i]) <= 0.0)
+				k--;
+			hull[k++] = uint32_t(i);
+		}
+		// Upper chain from right to left
+		size_t lowerCount = k + 1;
+		for (size_t i = count - 1; i-- > 0;)
+		{
+			while (k >= lowerCount && cross(x[hull[k - 2]], y[hull[k - 2]], x[hull[k - 1]], y[hull[k - 1]], x[i], y[i]) <= 0.0)
+				k--;
+			hull[k++] = uint32_t(i);
+		}
+		k--; // The first point was added again at the end
+
+		// All the points were the same
+		if (k == 2 && x[hull[0]] == x[hull[1]] && y[hull[0]] == y[hull[1]])
+			return 1;
+		return k;
+	}
+
+private:
+	// Copies the points into the sorted arrays in the order of _order
+	void copySortedPoints(const HullPoints& points)
+	{
+		size_t n = points.size();
+		_sortedX.resize(n);
+		_sortedY.resize(n);
+		_sortedIndex.resize(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			uint32_t index = _order[i];
+			_sortedX[i] = points._x[index];
+			_sortedY[i] = points._y[index];
+			_sortedIndex[i] = index;
+		}
+	}
+
+	// Unsigned key that sorts the same way as the float. -0 and 0 compare equal, so both get the key of 0
+	static uint32_t getSortKey(float value)
+	{
+		if (value == 0.0f)
+			value = 0.0f;
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+	}
+
+private:
+	static constexpr size_t _radixSortThreshold = 256;
+
+	std::vector<uint32_t> _keys;
+	std::vector<uint32_t> _keysTemp;
+	std::vector<uint32_t> _order;
+	std::vector<uint32_t> _orderTemp;
+
+	std::vector<float> _sortedX;
+	std::vector<float> _sortedY;
+	std::vector<uint32_t> _sortedIndex;
+	std::vector<uint32_t> _hull;
+};
@@ -0,0 +1,145 @@
+// PhiloxRandom.h
+// Nathan Damon
+// 2026-10-16
+// Philox4x32-10 counter based random numbers
+//
+// Each block of four numbers is worked out from its own counter and the
+// seed, with no state carried from one block to the next. Any part of a
+// sequence can be made without making the part before it, so threads can
+// each fill their own range of points and get the same numbers as one
+// thread would. Streams give a seed more than one independent sequence,
+// one for x and one for y for example.
+//
+// The numbers are made in groups of four blocks. On x86-64 the four blocks
+// of a group are worked out side by side in SSE2 registers, elsewhere one
+// after the other. Both ways give the same numbers in the same order.
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PHILOX_SSE2
+#include <emmintrin.h>
+#endif
+
+class PhiloxRandom
+{
+public:
+	// Numbers in a group, word w of block b of the group is at w * 4 + b
+	static constexpr size_t groupSize = 16;
+
+	// The four words of one block, block is the counter within the stream
+	static void generateBlock(uint64_t seed, uint32_t stream, uint64_t block, uint32_t out[4])
+	{
+		uint32_t c0 = uint32_t(block), c1 = uint32_t(block >> 32), c2 = stream, c3 = 0;
+		uint32_t k0 = uint32_t(seed), k1 = uint32_t(seed >> 32);
+		for (int round = 0; round < 10; round++)
+		{
+			if (round > 0)
+			{
+				k0 += _weyl0;
+				k1 += _weyl1;
+			}
+			uint64_t product0 = uint64_t(_multiplier0) * c0;
+			uint64_t product1 = uint64_t(_multiplier1) * c2;
+			uint32_t next0 = uint32_t(product1 >> 32) ^ c1 ^ k0;
+			uint32_t next2 = uint32_t(product0 >> 32) ^ c3 ^ k1;
+			c1 = uint32_t(product1);
+			c3 = uint32_t(product0);
+			c0 = next0;
+			c2 = next2;
+		}
+		out[0] = c0;
+		out[1] = c1;
+		out[2] = c2;
+		out[3] = c3;
+	}
+
+	// Blocks group * 4 to group * 4 + 3 of the stream
+	static void generateGroup(uint64_t seed, uint32_t stream, uint64_t group, uint32_t out[groupSize])
+	{
+#if defined(PHILOX_SSE2)
+		generateGroupSSE2(seed, stream, group, out);
+#else
+		for (uint64_t block = 0; block < 4; block++)
+		{
+			uint32_t words[4];
+			generateBlock(seed, stream, group * 4 + block, words);
+			for (int word = 0; word < 4; word++)
+				out[word * 4 + block] = words[word];
+		}
+#endif
+	}
+
+	// The group as floats in [0, 1), from the top 24 bits of each number so every one is exact
+	static void uniformGroup(uint64_t seed, uint32_t stream, uint64_t group, float out[groupSize])
+	{
+		alignas(16) uint32_t bits[groupSize];
+		generateGroup(seed, stream, group, bits);
+#if defined(PHILOX_SSE2)
+		const __m128 scale = _mm_set1_ps(1.0f / 16777216.0f);
+		for (size_t i = 0; i < groupSize; i += 4)
+		{
+			__m128i top = _mm_srli_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(bits + i)), 8);
+			_mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(top), scale));
+		}
+#else
+		for (size_t i = 0; i < groupSize; i++)
+			out[i] = float(bits[i] >> 8) * (1.0f / 16777216.0f);
+#endif
+	}
+
+private:
+#if defined(PHILOX_SSE2)
+	// Low and high halves of the 32 by 32 bit products of every lane with a number
+	static void multiplyLanes(__m128i lanes, __m128i multiplier, __m128i& low, __m128i& high)
+	{
+		// _mm_mul_epu32 only multiplies lanes 0 and 2, so lanes 1 and 3 are shifted down for a second one
+		__m128i even = _mm_mul_epu32(lanes, multiplier);
+		__m128i odd = _mm_mul_epu32(_mm_srli_epi64(lanes, 32), multiplier);
+		even = _mm_shuffle_epi32(even, _MM_SHUFFLE(3, 1, 2, 0));
+		odd = _mm_shuffle_epi32(odd, _MM_SHUFFLE(3, 1, 2, 0));
+		low = _mm_unpacklo_epi32(even, odd);
+		high = _mm_unpackhi_epi32(even, odd);
+	}
+	static void generateGroupSSE2(uint64_t seed, uint32_t stream, uint64_t group, uint32_t out[groupSize])
+	{
+		// Lane b holds word w of block group * 4 + b
+		uint64_t first = group * 4;
+		__m128i c0 = _mm_setr_epi32(int(uint32_t(first)), int(uint32_t(first + 1)), int(uint32_t(first + 2)), int(uint32_t(first + 3)));
+		__m128i c1 = _mm_setr_epi32(int(uint32_t(first >> 32)), int(uint32_t((first + 1) >> 32)), int(uint32_t((first + 2) >> 32)), int(uint32_t((first + 3) >> 32)));
+		__m128i c2 = _mm_set1_epi32(int(stream));
+		__m128i c3 = _mm_setzero_si128();
+		const __m128i multiplier0 = _mm_set1_epi32(int(_multiplier0));
+		const __m128i multiplier1 = _mm_set1_epi32(int(_multiplier1));
+		uint32_t k0 = uint32_t(seed), k1 = uint32_t(seed >> 32);
+
+		for (int round = 0; round < 10; round++)
+		{
+			if (round > 0)
+			{
+				k0 += _weyl0;
+				k1 += _weyl1;
+			}
+			__m128i low0, high0, low1, high1;
+			multiplyLanes(c0, multiplier0, low0, high0);
+			multiplyLanes(c2, multiplier1, low1, high1);
+			c0 = _mm_xor_si128(_mm_xor_si128(high1, c1), _mm_set1_epi32(int(k0)));
+			c2 = _mm_xor_si128(_mm_xor_si128(high0, c3), _mm_set1_epi32(int(k1)));
+			c1 = low1;
+			c3 = low0;
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 0), c0);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), c1);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), c2);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), c3);
+	}
+#endif
+
+private:
+	static constexpr uint32_t _multiplier0 = 0xD2511F53;
+	static constexpr uint32_t _multiplier1 = 0xCD9E8D57;
+	static constexpr uint32_t _weyl0 = 0x9E3779B9; // Added to the key every round
+	static constexpr uint32_t _weyl1 = 0xBB67AE85;
+};
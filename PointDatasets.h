@@ -0,0 +1,389 @@
+// PointDatasets.h
+// Nathan Damon
+// 2026-10-16
+// Reproducible point sets for running and timing the hull engines
+//
+// Every dataset is placed in the unit square and is made the same way
+// every time for the same seed and point count. The random numbers come
+// from PhiloxRandom, so the points can be made in parallel chunks and
+// still come out the same however many threads there are.
+//
+// Each dataset also has a 3D version for QuickHull3D in the unit cube: the
+// square is the cube, the disk is the ball, the circles are spheres and the
+// annulus is a spherical shell.
+
+#pragma once
+#include "HullPoints.h"
+#include "HullPoints3D.h"
+#include "PhiloxRandom.h"
+#include "TaskPool.h"
+#include <string>
+#include <cmath>
+
+class PointDatasets
+{
+public:
+	enum class Dataset
+	{
+		UniformSquare,	// Uniform in the unit square
+		UniformDisk,	// Uniform in the disk touching the sides of the square
+		OnCircle,		// Spread around a circle by the golden angle, every point is on the hull
+		Gaussian,		// Normal distribution around the center
+		Clustered,		// Small normal distributions around random centers
+		Annulus,		// Uniform in a ring, so many points are near the hull
+		NoisyCircle,	// Spread around a circle and moved in or out by a tiny amount
+		Count
+	};
+
+public:
+	// Fills the points from start to the end, so added points can be placed without
+	// moving the ones before them. A point only depends on the seed and its index
+	static void generate(Dataset dataset, HullPoints& points, uint64_t seed, size_t start = 0)
+	{
+		switch (dataset)
+		{
+		case Dataset::UniformSquare:
+			placeUniformlyInSquare(points, seed, start);
+			break;
+		case Dataset::UniformDisk:
+			placeUniformlyInDisk(points, seed, start);
+			break;
+		case Dataset::OnCircle:
+			placeUniformlyOnCircle(points, start);
+			break;
+		case Dataset::Gaussian:
+			placeGaussian(points, seed, start);
+			break;
+		case Dataset::Clustered:
+			placeClustered(points, seed, start);
+			break;
+		case Dataset::Annulus:
+			placeInAnnulus(points, seed, start);
+			break;
+		case Dataset::NoisyCircle:
+			placeOnNoisyCircle(points, seed, start);
+			break;
+		default:
+			break;
+		}
+	}
+
+	static void placeUniformlyInSquare(HullPoints& points, uint64_t seed, size_t start = 0)
+	{
+		forEachPoint<2>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				points.setPoint(i, uniforms[0], uniforms[1]);
+			});
+	}
+	static void placeUniformlyInDisk(HullPoints& points, uint64_t seed, size_t start = 0)
+	{
+		forEachPoint<2>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				// The square root keeps the density even across the disk
+				float radius = sqrtf(uniforms[0]) * 0.5f;
+				float angle = uniforms[1] * 6.2831853f;
+				points.setPoint(i, cosf(angle) * radius + 0.5f, sinf(angle) * radius + 0.5f);
+			});
+	}
+	// The worst case for QuickHull, every point is a corner of the hull
+	static void placeUniformlyOnCircle(HullPoints& points, size_t start = 0)
+	{
+		for (size_t i = start; i < points.size(); i++)
+		{
+			float angle = getCircleAngle(i);
+			points.setPoint(i, cosf(angle) * 0.5f + 0.5f, sinf(angle) * 0.5f + 0.5f);
+		}
+	}
+	static void placeGaussian(HullPoints& points, uint64_t seed, size_t start = 0)
+	{
+		forEachPoint<2>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				float x, y;
+				getNormalPair(uniforms[0], uniforms[1], x, y);
+				points.setPoint(i, x * 0.15f + 0.5f, y * 0.15f + 0.5f);
+			});
+	}
+	static void placeClustered(HullPoints& points, uint64_t seed, size_t start = 0)
+	{
+		// The centers have streams of their own, after the ones the points use
+		float centerX[_clusterCount];
+		float centerY[_clusterCount];
+		placeClusterCenters(seed, 3, centerX);
+		placeClusterCenters(seed, 4, centerY);
+
+		forEachPoint<3>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				size_t cluster = std::min(size_t(uniforms[0] * float(_clusterCount)), _clusterCount - 1);
+				float x, y;
+				getNormalPair(uniforms[1], uniforms[2], x, y);
+				points.setPoint(i, centerX[cluster] + x * 0.02f, centerY[cluster] + y * 0.02f);
+			});
+	}
+	static void placeInAnnulus(HullPoints& points, uint64_t seed, size_t start = 0)
+	{
+		const float inner = 0.35f;
+		const float outer = 0.5f;
+		forEachPoint<2>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				// Uniform in the squared radius keeps the density even across the ring
+				float radius = sqrtf(inner * inner + uniforms[0] * (outer * outer - inner * inner));
+				float angle = uniforms[1] * 6.2831853f;
+				points.setPoint(i, cosf(angle) * radius + 0.5f, sinf(angle) * radius + 0.5f);
+			});
+	}
+	// Points a few float steps off the circle, so many of them are nearly in line
+	// with hull edges and the orientation tests have to be exact to get them right
+	static void placeOnNoisyCircle(HullPoints& points, uint64_t seed, size_t start = 0)
+	{
+		forEachPoint<2>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				float noise, unused;
+				getNormalPair(uniforms[0], uniforms[1], noise, unused);
+				float radius = 0.5f + noise * 1e-6f;
+				float angle = getCircleAngle(i);
+				points.setPoint(i, cosf(angle) * radius + 0.5f, sinf(angle) * radius + 0.5f);
+			});
+	}
+
+	// The 3D version of each dataset
+	static void generate(Dataset dataset, HullPoints3D& points, uint64_t seed, size_t start = 0)
+	{
+		switch (dataset)
+		{
+		case Dataset::UniformSquare:
+			placeUniformlyInCube(points, seed, start);
+			break;
+		case Dataset::UniformDisk:
+			placeUniformlyInBall(points, seed, start);
+			break;
+		case Dataset::OnCircle:
+			placeEvenlyOnSphere(points, start);
+			break;
+		case Dataset::Gaussian:
+			placeGaussian(points, seed, start);
+			break;
+		case Dataset::Clustered:
+			placeClustered(points, seed, start);
+			break;
+		case Dataset::Annulus:
+			placeInShell(points, seed, start);
+			break;
+		case Dataset::NoisyCircle:
+			placeOnNoisySphere(points, seed, start);
+			break;
+		default:
+			break;
+		}
+	}
+
+	static void placeUniformlyInCube(HullPoints3D& points, uint64_t seed, size_t start = 0)
+	{
+		forEachPoint<3>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				points.setPoint(i, uniforms[0], uniforms[1], uniforms[2]);
+			});
+	}
+	static void placeUniformlyInBall(HullPoints3D& points, uint64_t seed, size_t start = 0)
+	{
+		forEachPoint<3>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				// The cube root keeps the density even through the ball
+				float radius = cbrtf(uniforms[2]) * 0.5f;
+				float x, y, z;
+				getDirection(uniforms[0], uniforms[1], x, y, z);
+				points.setPoint(i, x * radius + 0.5f, y * radius + 0.5f, z * radius + 0.5f);
+			});
+	}
+	// The worst case for QuickHull3D, every point is on the hull or very nearly
+	static void placeEvenlyOnSphere(HullPoints3D& points, size_t start = 0)
+	{
+		for (size_t i = start; i < points.size(); i++)
+		{
+			float x, y, z;
+			getSpherePoint(i, x, y, z);
+			points.setPoint(i, x * 0.5f + 0.5f, y * 0.5f + 0.5f, z * 0.5f + 0.5f);
+		}
+	}
+	static void placeGaussian(HullPoints3D& points, uint64_t seed, size_t start = 0)
+	{
+		forEachPoint<4>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				float x, y, z, unused;
+				getNormalPair(uniforms[0], uniforms[1], x, y);
+				getNormalPair(uniforms[2], uniforms[3], z, unused);
+				points.setPoint(i, x * 0.15f + 0.5f, y * 0.15f + 0.5f, z * 0.15f + 0.5f);
+			});
+	}
+	static void placeClustered(HullPoints3D& points, uint64_t seed, size_t start = 0)
+	{
+		float centerX[_clusterCount];
+		float centerY[_clusterCount];
+		float centerZ[_clusterCount];
+		placeClusterCenters(seed, 5, centerX);
+		placeClusterCenters(seed, 6, centerY);
+		placeClusterCenters(seed, 7, centerZ);
+
+		forEachPoint<5>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				size_t cluster = std::min(size_t(uniforms[0] * float(_clusterCount)), _clusterCount - 1);
+				float x, y, z, unused;
+				getNormalPair(uniforms[1], uniforms[2], x, y);
+				getNormalPair(uniforms[3], uniforms[4], z, unused);
+				points.setPoint(i, centerX[cluster] + x * 0.02f, centerY[cluster] + y * 0.02f, centerZ[cluster] + z * 0.02f);
+			});
+	}
+	static void placeInShell(HullPoints3D& points, uint64_t seed, size_t start = 0)
+	{
+		const float inner = 0.35f;
+		const float outer = 0.5f;
+		forEachPoint<3>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				// Uniform in the cubed radius keeps the density even through the shell
+				float radius = cbrtf(inner * inner * inner + uniforms[2] * (outer * outer * outer - inner * inner * inner));
+				float x, y, z;
+				getDirection(uniforms[0], uniforms[1], x, y, z);
+				points.setPoint(i, x * radius + 0.5f, y * radius + 0.5f, z * radius + 0.5f);
+			});
+	}
+	static void placeOnNoisySphere(HullPoints3D& points, uint64_t seed, size_t start = 0)
+	{
+		forEachPoint<2>(points.size(), seed, start, [&](size_t i, const float* uniforms)
+			{
+				float noise, unused;
+				getNormalPair(uniforms[0], uniforms[1], noise, unused);
+				float radius = 0.5f + noise * 1e-6f;
+				float x, y, z;
+				getSpherePoint(i, x, y, z);
+				points.setPoint(i, x * radius + 0.5f, y * radius + 0.5f, z * radius + 0.5f);
+			});
+	}
+
+	static std::string getName(Dataset dataset)
+	{
+		switch (dataset)
+		{
+		case Dataset::UniformSquare:
+			return "uniform-square";
+		case Dataset::UniformDisk:
+			return "uniform-disk";
+		case Dataset::OnCircle:
+			return "on-circle";
+		case Dataset::Gaussian:
+			return "gaussian";
+		case Dataset::Clustered:
+			return "clustered";
+		case Dataset::Annulus:
+			return "annulus";
+		case Dataset::NoisyCircle:
+			return "noisy-circle";
+		default:
+			return "Error in getName";
+		}
+	}
+	// Returns false when the name is not a dataset
+	static bool getDataset(const std::string& name, Dataset& dataset)
+	{
+		for (int i = 0; i < static_cast<int>(Dataset::Count); i++)
+		{
+			if (getName(static_cast<Dataset>(i)) == name)
+			{
+				dataset = static_cast<Dataset>(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	// Calls place(i, uniforms) for every point from start up to pointCount, where uniforms[s] is the
+	// number in [0, 1) for point i from stream s. The points are split into chunks on
+	// the TaskPool, each chunk making the random numbers for its own points
+	template <size_t StreamCount, typename Place>
+	static void forEachPoint(size_t pointCount, uint64_t seed, size_t start, Place&& place)
+	{
+		const size_t groupSize = PhiloxRandom::groupSize;
+		if (start >= pointCount)
+			return;
+		size_t firstGroup = start / groupSize;
+		size_t groupCount = (pointCount + groupSize - 1) / groupSize - firstGroup;
+
+		TaskPool& pool = TaskPool::getInstance();
+		size_t chunkCount = groupCount < _serialGroupCount ? 1 : pool.getThreadCount() * 4;
+		pool.parallelFor(groupCount, chunkCount, [&](size_t chunk, size_t begin, size_t end)
+			{
+				(void)chunk;
+				float uniforms[StreamCount][groupSize];
+				for (size_t group = firstGroup + begin; group < firstGroup + end; group++)
+				{
+					for (size_t stream = 0; stream < StreamCount; stream++)
+						PhiloxRandom::uniformGroup(seed, uint32_t(stream), group, uniforms[stream]);
+
+					size_t first = std::max(start, group * groupSize);
+					size_t last = std::min(pointCount, (group + 1) * groupSize);
+					for (size_t i = first; i < last; i++)
+					{
+						float pointUniforms[StreamCount];
+						for (size_t stream = 0; stream < StreamCount; stream++)
+							pointUniforms[stream] = uniforms[stream][i - group * groupSize];
+						place(i, pointUniforms);
+					}
+				}
+			});
+	}
+
+	// One coordinate of every cluster center, from its own stream
+	static void placeClusterCenters(uint64_t seed, uint32_t stream, float* centers)
+	{
+		for (size_t group = 0; group * PhiloxRandom::groupSize < _clusterCount; group++)
+		{
+			float uniforms[PhiloxRandom::groupSize];
+			PhiloxRandom::uniformGroup(seed, stream, group, uniforms);
+			for (size_t i = 0; i < PhiloxRandom::groupSize && group * PhiloxRandom::groupSize + i < _clusterCount; i++)
+				centers[group * PhiloxRandom::groupSize + i] = uniforms[i] * 0.8f + 0.1f;
+		}
+	}
+	// Angle of point i on the circle datasets. Stepping by the golden angle spreads any number of
+	// points about evenly around the circle without the step depending on the count, so adding
+	// points does not move the ones already placed. The angle is kept in double, since i times
+	// the step is far past where float can tell neighbouring points apart
+	static float getCircleAngle(size_t i)
+	{
+		return float(std::fmod(double(i) * 2.399963229728653, 6.283185307179586));
+	}
+
+	// Two independent standard normal numbers from two uniform ones (Box-Muller)
+	static void getNormalPair(float uniform0, float uniform1, float& normal0, float& normal1)
+	{
+		// 1 - uniform0 is never zero, so the log is finite
+		float radius = sqrtf(-2.0f * logf(1.0f - uniform0));
+		float angle = uniform1 * 6.2831853f;
+		normal0 = radius * cosf(angle);
+		normal1 = radius * sinf(angle);
+	}
+	// A point on the unit sphere from two uniform numbers, even over the sphere
+	static void getDirection(float uniform0, float uniform1, float& x, float& y, float& z)
+	{
+		z = 1.0f - 2.0f * uniform0;
+		float radius = sqrtf(std::max(0.0f, 1.0f - z * z));
+		float angle = uniform1 * 6.2831853f;
+		x = cosf(angle) * radius;
+		y = sinf(angle) * radius;
+	}
+	// Point i spread over the unit sphere. The height and the angle around the axis step by the two
+	// fractions of the plastic number (the R2 sequence), which spreads any number of points about
+	// evenly without the steps depending on the count, so adding points does not move the ones
+	// already placed. They are worked out in double, in float they are lost after a few million steps
+	static void getSpherePoint(size_t i, float& x, float& y, float& z)
+	{
+		double height = 1.0 - 2.0 * std::fmod(0.5 + double(i) * 0.7548776662466927, 1.0);
+		double radius = std::sqrt(std::max(0.0, 1.0 - height * height));
+		double angle = std::fmod(0.5 + double(i) * 0.5698402909980532, 1.0) * 6.283185307179586;
+		x = float(std::cos(angle) * radius);
+		y = float(std::sin(angle) * radius);
+		z = float(height);
+	}
+
+private:
+	static constexpr size_t _clusterCount = 32;
+	static constexpr size_t _serialGroupCount = 4096; // Fewer groups than this are not worth splitting up
+};
@@ -0,0 +1,453 @@
+// PointGrid.h
+// Nathan Damon
+// 2026-10-16
+// Uniform grid over HullPoints for finding points near a spot
+//
+// The bounding box of the points, padded so points can move a little
+// without leaving it, is cut into cells of about _pointsPerCell points.
+// The point indices of each cell sit together in one array, CSR style,
+// with room left at the end of every cell. Building finds the cells,
+// counts and places the points over the TaskPool: each chunk of points
+// counts and copies its own points into rows, then each band of rows
+// places its points into its cells. When points move or are added, update
+// only moves the points that changed cell into the room left in their new
+// cell, and builds again when a cell is full, a point leaves the box or
+// too many points changed.
+//
+// The queries take the points the grid was built from, so the hull
+// engines and the render side can both use them. After a build the
+// points of a cell are in index order, update can leave them out of it.
+
+#pragma once
+#include "HullPoints.h"
+#include "TaskPool.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+class PointGrid
+{
+public:
+	static constexpr uint32_t noPoint = 0xFFFFFFFF;
+
+public:
+	PointGrid() {}
+	~PointGrid() {}
+
+	void build(const HullPoints& points)
+	{
+		size_t n = points.size();
+		_pointCell.resize(n);
+		_pointSlot.resize(n);
+		TaskPool& pool = TaskPool::getInstance();
+		size_t chunkCount = n >= _parallelThreshold ? pool.getThreadCount() * 4 : 1;
+
+		// Bounding box, each chunk finds its own and they are merged after
+		_chunkBounds.assign(chunkCount, Bounds());
+		pool.parallelFor(n, chunkCount, [&](size_t chunk, size_t begin, size_t end)
+			{
+				Bounds& bounds = _chunkBounds[chunk];
+				for (size_t i = begin; i < end; i++)
+				{
+					bounds._minX = std::min(bounds._minX, points._x[i]);
+					bounds._minY = std::min(bounds._minY, points._y[i]);
+					bounds._maxX = std::max(bounds._maxX, points._x[i]);
+					bounds._maxY = std::max(bounds._maxY, points._y[i]);
+				}
+			});
+		Bounds bounds;
+		for (auto& chunkBounds : _chunkBounds)
+		{
+			bounds._minX = std::min(bounds._minX, chunkBounds._minX);
+			bounds._minY = std::min(bounds._minY, chunkBounds._minY);
+			bounds._maxX = std::max(bounds._maxX, chunkBounds._maxX);
+			bounds._maxY = std::max(bounds._maxY, chunkBounds._maxY);
+		}
+		if (n == 0)
+			bounds = { 0.0f, 0.0f, 1.0f, 1.0f };
+		setCells(bounds, n);
+
+		// Each chunk counts its points in every row, then the counts are added up row by row in chunk
+		// order so each chunk knows where its points of each row go. Copying them there groups the
+		// points by row in index order, without atomics and looking at each point once
+		size_t rowCount = size_t(_rows);
+		_chunkRowStart.assign(chunkCount * rowCount, 0);
+		pool.parallelFor(n, chunkCount, [&](size_t chunk, size_t begin, size_t end)
+			{
+				uint32_t* rowCounts = _chunkRowStart.data() + chunk * rowCount;
+				for (size_t i = begin; i < end; i++)
+				{
+					uint32_t cell = getCell(points._x[i], points._y[i]);
+					_pointCell[i] = cell;
+					rowCounts[cell / uint32_t(_columns)]++;
+				}
+			});
+		_rowStart.resize(rowCount + 1);
+		uint32_t rowStart = 0;
+		for (size_t row = 0; row < rowCount; row++)
+		{
+			_rowStart[row] = rowStart;
+			for (size_t chunk = 0; chunk < chunkCount; chunk++)
+			{
+				uint32_t& start = _chunkRowStart[chunk * rowCount + row];
+				uint32_t count = start;
+				start = rowStart;
+				rowStart += count;
+			}
+		}
+		_rowStart[rowCount] = rowStart;
+		_rowPoints.resize(n);
+		pool.parallelFor(n, chunkCount, [&](size_t chunk, size_t begin, size_t end)
+			{
+				uint32_t* rowSlots = _chunkRowStart.data() + chunk * rowCount;
+				for (size_t i = begin; i < end; i++)
+					_rowPoints[rowSlots[_pointCell[i] / uint32_t(_columns)]++] = uint32_t(i);
+			});
+
+		// Then each task sorts the points of its own band of rows into their cells, which keeps them in
+		// index order. The rows are laid out one after another, so only the start of each row has to be
+		// found before the cells can be placed
+		size_t cellCount = size_t(_columns) * size_t(_rows);
+		_cellStart.resize(cellCount + 1);
+		_cellCount.assign(cellCount, 0);
+		_rowSlotStart.resize(rowCount);
+		pool.parallelFor(rowCount, chunkCount, [&](size_t chunk, size_t beginRow, size_t endRow)
+			{
+				(void)chunk;
+				for (size_t row = beginRow; row < endRow; row++)
+				{
+					for (uint32_t p = _rowStart[row]; p < _rowStart[row + 1]; p++)
+						_cellCount[_pointCell[_rowPoints[p]]]++;
+					uint32_t room = 0;
+					for (size_t cell = row * _columns; cell < (row + 1) * _columns; cell++)
+						room += getRoom(_cellCount[cell]);
+					_rowSlotStart[row] = room;
+				}
+			});
+		uint32_t slotStart = 0;
+		for (size_t row = 0; row < rowCount; row++)
+		{
+			uint32_t room = _rowSlotStart[row];
+			_rowSlotStart[row] = slotStart;
+			slotStart += room;
+		}
+		_cellStart[cellCount] = slotStart;
+		_slots.resize(slotStart);
+
+		pool.parallelFor(rowCount, chunkCount, [&](size_t chunk, size_t beginRow, size_t endRow)
+			{
+				(void)chunk;
+				for (size_t row = beginRow; row < endRow; row++)
+				{
+					uint32_t start = _rowSlotStart[row];
+					for (size_t cell = row * _columns; cell < (row + 1) * _columns; cell++)
+					{
+						_cellStart[cell] = start;
+						start += getRoom(_cellCount[cell]);
+						_cellCount[cell] = 0;
+					}
+					for (uint32_t p = _rowStart[row]; p < _rowStart[row + 1]; p++)
+					{
+						uint32_t i = _rowPoints[p];
+						uint32_t cell = _pointCell[i];
+						uint32_t slot = _cellStart[cell] + _cellCount[cell]++;
+						_slots[slot] = i;
+						_pointSlot[i] = slot;
+					}
+				}
+			});
+	}
+
+	// Catches up with points that moved and points added to the end
+	// Returns false when it had to build the grid again instead
+	bool update(const HullPoints& points)
+	{
+		size_t n = points.size();
+		size_t oldCount = _pointCell.size();
+		if (_cellStart.empty() || n < oldCount)
+		{
+			build(points);
+			return false;
+		}
+
+		// Past a quarter of the points, building again is quicker than moving them one at a time
+		size_t movedLimit = n / 4;
+		size_t moved = 0;
+		_pointCell.resize(n);
+		_pointSlot.resize(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			float x = points._x[i];
+			float y = points._y[i];
+			if (x < _minX || x > _maxX || y < _minY || y > _maxY)
+			{
+				build(points);
+				return false;
+			}
+			uint32_t cell = getCell(x, y);
+			if (i < oldCount && cell == _pointCell[i])
+				continue;
+			if (++moved > movedLimit || _cellCount[cell] == _cellStart[cell + 1] - _cellStart[cell])
+			{
+				build(points);
+				return false;
+			}
+
+			if (i < oldCount)
+				removeFromCell(uint32_t(i));
+			uint32_t slot = _cellStart[cell] + _cellCount[cell]++;
+			_slots[slot] = uint32_t(i);
+			_pointCell[i] = cell;
+			_pointSlot[i] = slot;
+		}
+		return true;
+	}
+
+	// The point closest to x, y that accept(index) is true for, or noPoint when there is none
+	// The cells are searched in rings around the one x, y is in, until no closer point can be left
+	template <typename Accept>
+	uint32_t findNearest(const HullPoints& points, float x, float y, Accept&& accept) const
+	{
+		if (_pointCell.empty())
+			return noPoint;
+
+		int column = getColumn(x);
+		int row = getRow(y);
+		float cellSize = std::min(_cellWidth, _cellHeight);
+		uint32_t nearest = noPoint;
+		float nearestDistance = std::numeric_limits<float>::max();
+		int ringCount = std::max(_columns, _rows);
+		for (int ring = 0; ring <= ringCount; ring++)
+		{
+			// Every cell of this ring is at least ring - 1 whole cells away
+			float ringDistance = float(ring - 1) * cellSize;
+			if (nearest != noPoint && ringDistance * ringDistance > nearestDistance)
+				break;
+
+			for (int cellRow = row - ring; cellRow <= row + ring; cellRow++)
+			{
+				if (cellRow < 0 || cellRow >= _rows)
+					continue;
+				// The top and bottom rows of the ring are whole, the rows between only have their two ends
+				bool wholeRow = cellRow == row - ring || cellRow == row + ring;
+				int step = wholeRow ? 1 : std::max(1, 2 * ring);
+				for (int cellColumn = column - ring; cellColumn <= column + ring; cellColumn += step)
+				{
+					if (cellColumn < 0 || cellColumn >= _columns)
+						continue;
+					uint32_t cell = uint32_t(cellRow * _columns + cellColumn);
+					for (uint32_t slot = _cellStart[cell]; slot < _cellStart[cell] + _cellCount[cell]; slot++)
+					{
+						uint32_t index = _slots[slot];
+						float dx = points._x[index] - x;
+						float dy = points._y[index] - y;
+						float distance = dx * dx + dy * dy;
+						if (distance < nearestDistance && accept(index))
+						{
+							nearestDistance = distance;
+							nearest = index;
+						}
+					}
+				}
+			}
+		}
+		return nearest;
+	}
+
+	// Adds the points inside the rectangle, edges included, to found
+	void findInRect(const HullPoints& points, float x0, float y0, float x1, float y1, std::vector<uint32_t>& found) const
+	{
+		if (_pointCell.empty())
+			return;
+		if (x1 < x0)
+			std::swap(x0, x1);
+		if (y1 < y0)
+			std::swap(y0, y1);
+
+		int lastRow = getRow(y1);
+		int lastColumn = getColumn(x1);
+		for (int row = getRow(y0); row <= lastRow; row++)
+		{
+			for (int column = getColumn(x0); column <= lastColumn; column++)
+			{
+				uint32_t cell = uint32_t(row * _columns + column);
+				for (uint32_t slot = _cellStart[cell]; slot < _cellStart[cell] + _cellCount[cell]; slot++)
+				{
+					uint32_t index = _slots[slot];
+					float x = points._x[index];
+					float y = points._y[index];
+					if (x >= x0 && x <= x1 && y >= y0 && y <= y1)
+						found.push_back(index);
+				}
+			}
+		}
+	}
+
+	// Adds the points within epsilon of the line segment A-B to found
+	// Each row of cells only looks at the columns the segment passes over within epsilon of the row
+	void findNearSegment(const HullPoints& points, float ax, float ay, float bx, float by, float epsilon, std::vector<uint32_t>& found) const
+	{
+		if (_pointCell.empty())
+			return;
+
+		float dx = bx - ax;
+		float dy = by - ay;
+		float lengthSquared = dx * dx + dy * dy;
+		float epsilonSquared = epsilon * epsilon;
+		int lastRow = getRow(std::max(ay, by) + epsilon);
+		for (int row = getRow(std::min(ay, by) - epsilon); row <= lastRow; row++)
+		{
+			// The part of the segment within epsilon of the row in y
+			float bandStart = _minY + float(row) * _cellHeight - epsilon;
+			float bandEnd = bandStart + _cellHeight + 2.0f * epsilon;
+			float t0 = 0.0f;
+			float t1 = 1.0f;
+			if (dy != 0.0f)
+			{
+				t0 = (bandStart - ay) / dy;
+				t1 = (bandEnd - ay) / dy;
+				if (t1 < t0)
+					std::swap(t0, t1);
+				t0 = std::max(t0, 0.0f);
+				t1 = std::min(t1, 1.0f);
+				if (t0 > t1)
+					continue;
+			}
+			float segmentX0 = ax + t0 * dx;
+			float segmentX1 = ax + t1 * dx;
+			int lastColumn = getColumn(std::max(segmentX0, segmentX1) + epsilon);
+			for (int column = getColumn(std::min(segmentX0, segmentX1) - epsilon); column <= lastColumn; column++)
+			{
+				uint32_t cell = uint32_t(row * _columns + column);
+				for (uint32_t slot = _cellStart[cell]; slot < _cellStart[cell] + _cellCount[cell]; slot++)
+				{
+					uint32_t index = _slots[slot];
+					float px = points._x[index] - ax;
+					float py = points._y[index] - ay;
+					float t = lengthSquared > 0.0f ? std::min(1.0f, std::max(0.0f, (px * dx + py * dy) / lengthSquared)) : 0.0f;
+					float offsetX = px - t * dx;
+					float offsetY = py - t * dy;
+					if (offsetX * offsetX + offsetY * offsetY <= epsilonSquared)
+						found.push_back(index);
+				}
+			}
+		}
+	}
+
+	// Adds the points within epsilon of an edge of the hull, given in order, to found
+	// A point near two edges is only added once
+	void findNearHull(const HullPoints& points, const std::vector<uint32_t>& hullOrder, float epsilon, std::vector<uint32_t>& found) const
+	{
+		size_t start = found.size();
+		for (size_t i = 0; i < hullOrder.size(); i++)
+		{
+			uint32_t a = hullOrder[i];
+			uint32_t b = hullOrder[(i + 1) % hullOrder.size()];
+			findNearSegment(points, points._x[a], points._y[a], points._x[b], points._y[b], epsilon, found);
+		}
+		std::sort(found.begin() + start, found.end());
+		found.erase(std::unique(found.begin() + start, found.end()), found.end());
+	}
+
+	int getColumns() const
+	{
+		return _columns;
+	}
+	int getRows() const
+	{
+		return _rows;
+	}
+	// Points the grid holds
+	size_t size() const
+	{
+		return _pointCell.size();
+	}
+
+private:
+	struct Bounds
+	{
+		float _minX = std::numeric_limits<float>::max();
+		float _minY = std::numeric_limits<float>::max();
+		float _maxX = std::numeric_limits<float>::lowest();
+		float _maxY = std::numeric_limits<float>::lowest();
+	};
+
+	// Pads the bounds and picks a column and row count that keeps the cells near square
+	void setCells(const Bounds& bounds, size_t pointCount)
+	{
+		float width = std::max(bounds._maxX - bounds._minX, 1e-6f);
+		float height = std::max(bounds._maxY - bounds._minY, 1e-6f);
+		float padX = width * _padding;
+		float padY = height * _padding;
+		_minX = bounds._minX - padX;
+		_minY = bounds._minY - padY;
+		_maxX = bounds._maxX + padX;
+		_maxY = bounds._maxY + padY;
+		width = _maxX - _minX;
+		height = _maxY - _minY;
+
+		double cellCount = double(std::max(size_t(1), pointCount / _pointsPerCell));
+		_columns = int(std::min(cellCount, std::max(1.0, std::sqrt(cellCount * width / height))));
+		_rows = std::max(1, int(cellCount / _columns));
+		_cellWidth = width / float(_columns);
+		_cellHeight = height / float(_rows);
+	}
+
+	// Spots off the grid are clamped to its edge cells, so a query can start anywhere
+	int getColumn(float x) const
+	{
+		float column = (x - _minX) / _cellWidth;
+		return column <= 0.0f ? 0 : std::min(_columns - 1, int(column));
+	}
+	int getRow(float y) const
+	{
+		float row = (y - _minY) / _cellHeight;
+		return row <= 0.0f ? 0 : std::min(_rows - 1, int(row));
+	}
+	uint32_t getCell(float x, float y) const
+	{
+		return uint32_t(getRow(y) * _columns + getColumn(x));
+	}
+
+	// Each cell gets half again the room it needs and two more, so update can move points into it
+	static uint32_t getRoom(uint32_t count)
+	{
+		return count + count / 2 + 2;
+	}
+
+	// Moves the last point of the cell into the point's slot
+	void removeFromCell(uint32_t index)
+	{
+		uint32_t cell = _pointCell[index];
+		uint32_t last = _slots[_cellStart[cell] + --_cellCount[cell]];
+		_slots[_pointSlot[index]] = last;
+		_pointSlot[last] = _pointSlot[index];
+	}
+
+private:
+	static constexpr size_t _pointsPerCell = 2;
+	static constexpr float _padding = 1.0f / 16.0f;
+	static constexpr size_t _parallelThreshold = 1 << 14;
+
+	float _minX = 0.0f;
+	float _minY = 0.0f;
+	float _maxX = 0.0f;
+	float _maxY = 0.0f;
+	float _cellWidth = 1.0f;
+	float _cellHeight = 1.0f;
+	int _columns = 0;
+	int _rows = 0;
+
+	std::vector<uint32_t> _cellStart; // One more than the cells, a cell's room is up to the next cell's start
+	std::vector<uint32_t> _cellCount;
+	std::vector<uint32_t> _slots; // Point indices by cell
+	std::vector<uint32_t> _pointCell;
+	std::vector<uint32_t> _pointSlot;
+
+	// Kept between builds
+	std::vector<Bounds> _chunkBounds;
+	std::vector<uint32_t> _chunkRowStart; // Each chunk's count of points in each row, then where they go in _rowPoints
+	std::vector<uint32_t> _rowStart; // One more than the rows, a row's points in _rowPoints are up to the next row's start
+	std::vector<uint32_t> _rowPoints; // Point indices by row
+	std::vector<uint32_t> _rowSlotStart; // Each row's first slot
+};
@@ -14,6 +14,7 @@ using std::string;
 #include <sstream>
 #include <iomanip>
 using std::setw;
+#include <cstdint>
 using std::left;
 
 // Poker probability class
@@ -375,6 +376,55 @@ public:
 		return Hand::High_Card;
 	}
 
+	// Hand checking by table (Same result as checkHand)
+	// Three cards are looked up in a table of every order of three cards built once by checkHand,
+	// so the cards do not have to be sorted first. Any other hand falls back to checkHand
+	static Hand lookupHand(vector<Card>& cards)
+	{
+		if (cards.size() != 3)
+			return checkHand(cards);
+
+		return static_cast<Hand>(getHandTable()[getHandIndex(cards[0], cards[1], cards[2])]);
+	}
+	// Returns the index of the card in the deck from getDeck (0 - 51)
+	static int getCardIndex(const Card& card)
+	{
+		return static_cast<int>(card._suit) * 13 + static_cast<int>(card._rank);
+	}
+	// Returns the position of the three cards, in the order given, in the table of getHandTable (0 - 52^3 - 1)
+	static int getHandIndex(const Card& first, const Card& second, const Card& third)
+	{
+		return (getCardIndex(first) * 52 + getCardIndex(second)) * 52 + getCardIndex(third);
+	}
+	// A byte a hand keeps the 140608 entries in about 137 KB
+	static const vector<uint8_t>& getHandTable()
+	{
+		static const vector<uint8_t> handTable = buildHandTable();
+		return handTable;
+	}
+	static vector<uint8_t> buildHandTable()
+	{
+		auto deck = getDeck();
+		auto handTable = vector<uint8_t>(52 * 52 * 52);
+		auto hand = vector<Card>(3);
+
+		// Repeated cards are checked as well, so any three cards can be looked up
+		for (size_t i = 0; i < deck.size(); i++)
+		{
+			hand[0] = deck[i];
+			for (size_t j = 0; j < deck.size(); j++)
+			{
+				hand[1] = deck[j];
+				for (size_t k = 0; k < deck.size(); k++)
+				{
+					hand[2] = deck[k];
+					handTable[getHandIndex(hand[0], hand[1], hand[2])] = static_cast<uint8_t>(checkHand(hand));
+				}
+			}
+		}
+		return handTable;
+	}
+
 	void printStatistcs(bool withDraws)
 	{
 		generateCardCombinations();
@@ -688,6 +738,7 @@ public:
 		testsFailed += testStraight();
 		testsFailed += testFlush();
 		testsFailed += testCheckHand();
+		testsFailed += testLookupHand();
 
 		if (testsFailed > 0)
 			cout << "Tests failed: " << testsFailed << endl;
@@ -717,7 +768,7 @@ private:
 		{
 			// Check all hands and get frequencies
 			for (auto& hand : _allCardCombinations)
-				_statistics[static_cast<int>(checkHand(hand))]._frequency++;
+				_statistics[static_cast<int>(lookupHand(hand))]._frequency++;
 		}
 		else
 		{
@@ -830,7 +881,7 @@ private:
 		_handStatsTable.resetTable();
 		vector<vector<Card>> discardedCards;
 		// Draw 0
-		auto hand = checkHand(heldCards);
+		auto hand = lookupHand(heldCards);
 		discardedCards.push_back(vector<Card>());
 		_handStatsTable.addData(hand, 0);
 
@@ -856,7 +907,7 @@ private:
 						continue;
 
 					changedHand.push_back(remainingCards[j]);
-					_handStatsTable.addData(checkHand(changedHand), 1 + i);
+					_handStatsTable.addData(lookupHand(changedHand), 1 + i);
 					changedHand.pop_back();
 				}
 				discardedCards.push_back(vector<Card>({ droppedCard }));
@@ -932,7 +983,7 @@ private:
 			_amongTheWorstHands = DiscardAndReturn(heldCards, expectedReturn);
 		}
 		// Best high card hand
-		if (checkHand(heldCards) == Hand::High_Card)
+		if (lookupHand(heldCards) == Hand::High_Card)
 		{
 			if (_amongTheBestHighCardHands._expectedReturn < expectedReturn)
 			{
@@ -1472,6 +1523,36 @@ private:
 
 		return testsFailed;
 	}
+	// Every order of every three cards against checkHand
+	int testLookupHand()
+	{
+		int testsFailed = 0;
+		auto testCards = vector<Card>(3);
+		for (size_t i = 0; i < _deck.size(); i++)
+		{
+			for (size_t j = 0; j < _deck.size(); j++)
+			{
+				for (size_t k = 0; k < _deck.size(); k++)
+				{
+					testCards[0] = _deck[i];
+					testCards[1] = _deck[j];
+					testCards[2] = _deck[k];
+					auto result = lookupHand(testCards);
+					auto check = checkHand(testCards);
+					if (result != check)
+					{
+						cout << "TestLookupHand [FAILED]" << endl;
+						printCards(testCards);
+						cout << "Looked up as: " << getHandAsString(result) << endl;
+						cout << "Should have been: " << getHandAsString(check) << endl << endl;
+						testsFailed++;
+					}
+				}
+			}
+		}
+
+		return testsFailed;
+	}
 
 	void debugPrintExpectedValuesOfDraws()
 	{
@@ -1522,7 +1603,7 @@ private:
 			if (handSize > 1)
 				DC_CombinationsPayoutSumAndTable(deck, currentHand, handSize - 1, stats, i + 1);
 			else
-				stats[static_cast<int>(checkHand(currentHand))]._frequency++;
+				stats[static_cast<int>(lookupHand(currentHand))]._frequency++;
 		}
 	}
 
@@ -0,0 +1,624 @@
+// QuickHull3D.h
+// Nathan Damon
+// 2026-10-16
+// A QuickHull algorithm for points in 3D
+//
+// Starts from a tetrahedron of extreme points and gives every other point
+// to a face it is above, that face's conflict list. Points above none of
+// the faces are inside and are never looked at again. Then the point
+// farthest above a face is added, over and over: the faces it can see are
+// found with a walk out from that face, the edges between the faces it can
+// see and the ones it can not are the horizon, and a new triangle is made
+// from each horizon edge to the point. The conflict lists of the faces that
+// were seen are given out to the new triangles, or thrown out when a point
+// is above none of them. When no face has points left the faces are the
+// hull.
+//
+// Nothing is a pointer graph. Faces are triangles in one array and the
+// half-edges of face f are 3f, 3f + 1 and 3f + 2, going from vertex k of
+// the face to vertex k + 1, so only the twin of each half-edge is stored.
+// The conflict lists are linked through an array with one entry per point.
+// Removed faces are reused by the next new ones and every buffer is kept
+// between runs, so re-running on the same points does not allocate.
+//
+// Which side of a face a point is on is decided by the exact orientation
+// test, so a point on the plane of a face is never outside it and no
+// tolerance is needed. Flat parts of the hull are then made of several
+// triangles in the same plane. At the end these are merged into one
+// polygon face and the vertices in the middle of a straight side of a
+// polygon are dropped, so every face and vertex given out is a true one.
+
+#pragma once
+#include "HullPoints3D.h"
+#include "HullEngine.h"
+#include "HullPredicates.h"
+#include "MonotoneChainHull.h"
+#include <cmath>
+
+class QuickHull3D
+{
+public:
+	static constexpr uint32_t _none = 0xFFFFFFFF; // No point, face or half-edge
+
+	// A triangle, its half-edges are 3 * face + k from _vertex[k] to _vertex[(k + 1) % 3]
+	struct Face
+	{
+		uint32_t _vertex[3] = { 0, 0, 0 };
+		uint32_t _conflictHead = _none; // First point of the conflict list, the rest are linked through _nextConflict
+		uint32_t _farthestPoint = _none;
+		float _farthestHeight = 0.0f;
+		uint32_t _visitStamp = 0; // Stamp of the last added point whose walk decided if this face is visible
+		bool _visible = false;
+		bool _removed = false;
+	};
+
+public:
+	QuickHull3D() {}
+	~QuickHull3D() {}
+
+	std::string getName() const
+	{
+		return "QuickHull3D";
+	}
+
+	// Returns true on complete
+	// The on-hull bits of the hull vertices are set and every hull edge is added to edges once.
+	// Points all on one plane give a single polygon face and points all on one line give the
+	// edge between its two ends and no faces
+	bool computeHull(HullPoints3D& points, std::vector<HullEdge>& edges)
+	{
+		points.clearOnHull();
+		_faceVertices.clear();
+		_faceStarts.assign(1, 0);
+		_candidateCount = 0;
+		if (points.size() == 0)
+			return true;
+
+		uint32_t simplex[4];
+		int dimensions = findSimplex(points, simplex);
+		if (dimensions < 3)
+		{
+			addFlatHull(points, simplex, dimensions, edges);
+			return true;
+		}
+
+		buildSimplex(points, simplex);
+		assignPoints(points);
+		while (_pendingFaces.empty() == false)
+		{
+			uint32_t face = _pendingFaces.back();
+			_pendingFaces.pop_back();
+			if (_faces[face]._removed == false && _faces[face]._conflictHead != _none)
+				addPoint(points, face);
+		}
+
+		mergeFaces(points);
+		addEdges(points, edges);
+		return true;
+	}
+
+	// Vertices of every face one after another, each face counter clockwise seen from outside
+	const std::vector<uint32_t>& getFaceVertices() const
+	{
+		return _faceVertices;
+	}
+	// Face f is getFaceVertices()[getFaceStarts()[f]] up to getFaceVertices()[getFaceStarts()[f + 1]]
+	const std::vector<uint32_t>& getFaceStarts() const
+	{
+		return _faceStarts;
+	}
+	size_t getFaceCount() const
+	{
+		return _faceStarts.size() - 1;
+	}
+	// Points outside the first tetrahedron, the rest were thrown out before any face was added
+	size_t getCandidateCount() const
+	{
+		return _candidateCount;
+	}
+
+private:
+	// Picks four points that are not on one plane and returns 3. When there are no such four,
+	// returns 2 with three points of the plane, 1 with the two ends of the line, or 0 when all
+	// the points are the same
+	int findSimplex(const HullPoints3D& points, uint32_t simplex[4]) const
+	{
+		const float* x = points._x.data();
+		const float* y = points._y.data();
+		const float* z = points._z.data();
+		size_t n = points.size();
+
+		// The two farthest apart of the points with the least and greatest x, y and z
+		uint32_t least[3] = { 0, 0, 0 };
+		uint32_t greatest[3] = { 0, 0, 0 };
+		for (size_t i = 1; i < n; i++)
+		{
+			if (x[i] < x[least[0]]) least[0] = uint32_t(i);
+			if (x[i] > x[greatest[0]]) greatest[0] = uint32_t(i);
+			if (y[i] < y[least[1]]) least[1] = uint32_t(i);
+			if (y[i] > y[greatest[1]]) greatest[1] = uint32_t(i);
+			if (z[i] < z[least[2]]) least[2] = uint32_t(i);
+			if (z[i] > z[greatest[2]]) greatest[2] = uint32_t(i);
+		}
+		double farthest = 0.0;
+		simplex[0] = simplex[1] = 0;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			double ax = x[least[axis]], ay = y[least[axis]], az = z[least[axis]];
+			double bx = x[greatest[axis]], by = y[greatest[axis]], bz = z[greatest[axis]];
+			double distance = (bx - ax) * (bx - ax) + (by - ay) * (by - ay) + (bz - az) * (bz - az);
+			if (distance > farthest)
+			{
+				farthest = distance;
+				simplex[0] = least[axis];
+				simplex[1] = greatest[axis];
+			}
+		}
+		if (farthest == 0.0)
+			return 0;
+
+		// The point farthest from the line between them, by the size of the cross product
+		uint32_t a = simplex[0], b = simplex[1];
+		double abx = double(x[b]) - x[a], aby = double(y[b]) - y[a], abz = double(z[b]) - z[a];
+		farthest = 0.0;
+		for (size_t i = 0; i < n; i++)
+		{
+			double apx = double(x[i]) - x[a], apy = double(y[i]) - y[a], apz = double(z[i]) - z[a];
+			double cx = aby * apz - abz * apy, cy = abz * apx - abx * apz, cz = abx * apy - aby * apx;
+			double distance = cx * cx + cy * cy + cz * cz;
+			if (distance > farthest)
+			{
+				farthest = distance;
+				simplex[2] = uint32_t(i);
+			}
+		}
+		if (farthest == 0.0)
+		{
+			// Rounding can hide a point just off the line, the exact tests have the last word
+			size_t i = 0;
+			while (i < n && isOnLine(points, a, b, uint32_t(i)))
+				i++;
+			if (i == n)
+				return 1;
+			simplex[2] = uint32_t(i);
+		}
+
+		// The point farthest from the plane through the three
+		uint32_t c = simplex[2];
+		HullPredicates::Plane3D plane(x[a], y[a], z[a], x[b], y[b], z[b], x[c], y[c], z[c]);
+		farthest = 0.0;
+		for (size_t i = 0; i < n; i++)
+		{
+			double distance = std::fabs(plane.orientation(x[i], y[i], z[i]));
+			if (distance > farthest)
+			{
+				farthest = distance;
+				simplex[3] = uint32_t(i);
+			}
+		}
+		return farthest == 0.0 ? 2 : 3;
+	}
+	bool isOnLine(const HullPoints3D& points, uint32_t a, uint32_t b, uint32_t point) const
+	{
+		// On the line in 3D when on it seen along each of the axes
+		return HullPredicates::orientation(points._x[a], points._y[a], points._x[b], points._y[b], points._x[point], points._y[point]) == 0.0 &&
+			HullPredicates::orientation(points._y[a], points._z[a], points._y[b], points._z[b], points._y[point], points._z[point]) == 0.0 &&
+			HullPredicates::orientation(points._z[a], points._x[a], points._z[b], points._x[b], points._z[point], points._x[point]) == 0.0;
+	}
+
+	// The four faces of the tetrahedron, each turned so the fourth point is below it
+	void buildSimplex(const HullPoints3D& points, const uint32_t simplex[4])
+	{
+		_faces.clear();
+		_twins.clear();
+		_freeFaces.clear();
+		_pendingFaces.clear();
+		_stamp = 0;
+
+		const int faceCorners[4][4] = { { 0, 1, 2, 3 }, { 0, 1, 3, 2 }, { 0, 2, 3, 1 }, { 1, 2, 3, 0 } }; // The last one is the point left out
+		for (auto& corners : faceCorners)
+		{
+			uint32_t a = simplex[corners[0]], b = simplex[corners[1]], c = simplex[corners[2]];
+			if (height(points, a, b, c, simplex[corners[3]]) > 0.0)
+				std::swap(b, c);
+			newFace(a, b, c);
+		}
+
+		// Only 12 half-edges, the twin of each is the one going the other way
+		for (uint32_t edge = 0; edge < 12; edge++)
+		{
+			for (uint32_t twin = 0; twin < 12; twin++)
+			{
+				if (getFrom(edge) == getTo(twin) && getTo(edge) == getFrom(twin))
+					_twins[edge] = twin;
+			}
+		}
+	}
+
+	// Gives every point to the first face of the tetrahedron it is above
+	void assignPoints(const HullPoints3D& points)
+	{
+		size_t n = points.size();
+		_nextConflict.resize(n);
+		HullPredicates::Plane3D planes[4];
+		for (uint32_t face = 0; face < 4; face++)
+			planes[face] = getPlane(points, face);
+		for (size_t i = 0; i < n; i++)
+		{
+			for (uint32_t face = 0; face < 4; face++)
+			{
+				double pointHeight = planes[face].orientation(points._x[i], points._y[i], points._z[i]);
+				if (pointHeight > 0.0)
+				{
+					addConflict(face, uint32_t(i), pointHeight);
+					_candidateCount++;
+					break;
+				}
+			}
+		}
+		for (uint32_t face = 0; face < 4; face++)
+		{
+			if (_faces[face]._conflictHead != _none)
+				_pendingFaces.push_back(face);
+		}
+	}
+
+	// Adds the point farthest above the face to the hull
+	void addPoint(const HullPoints3D& points, uint32_t face)
+	{
+		uint32_t eye = _faces[face]._farthestPoint;
+		_stamp++;
+		findHorizon(points, face, eye);
+
+		// A triangle from each horizon edge to the eye. The horizon goes round in order, so the
+		// side of each new triangle going to the eye is the twin of the next one's side coming back
+		_newFaces.clear();
+		_newPlanes.clear();
+		for (uint32_t edge : _horizon)
+		{
+			uint32_t twin = _twins[edge];
+			uint32_t added = newFace(getFrom(edge), getTo(edge), eye);
+			_twins[3 * added] = twin;
+			_twins[twin] = 3 * added;
+			_newFaces.push_back(added);
+			_newPlanes.push_back(getPlane(points, added));
+		}
+		for (size_t i = 0; i < _newFaces.size(); i++)
+		{
+			uint32_t toEye = 3 * _newFaces[i] + 1;
+			uint32_t fromEye = 3 * _newFaces[(i + 1) % _newFaces.size()] + 2;
+			_twins[toEye] = fromEye;
+			_twins[fromEye] = toEye;
+		}
+
+		// The points of the faces that were seen go to the first new face they are above, the rest are inside.
+		// Every point is tested against the new faces, so their planes are only worked out once
+		for (uint32_t visibleFace : _visibleFaces)
+		{
+			uint32_t point = _faces[visibleFace]._conflictHead;
+			while (point != _none)
+			{
+				uint32_t next = _nextConflict[point];
+				if (point != eye)
+				{
+					for (size_t i = 0; i < _newFaces.size(); i++)
+					{
+						double pointHeight = _newPlanes[i].orientation(points._x[point], points._y[point], points._z[point]);
+						if (pointHeight > 0.0)
+						{
+							addConflict(_newFaces[i], point, pointHeight);
+							break;
+						}
+					}
+				}
+				point = next;
+			}
+			_faces[visibleFace]._removed = true;
+			_freeFaces.push_back(visibleFace);
+		}
+
+		for (uint32_t added : _newFaces)
+		{
+			if (_faces[added]._conflictHead != _none)
+				_pendingFaces.push_back(added);
+		}
+	}
+
+	// Finds the faces the eye is above, starting from one of them, and the horizon edges around them.
+	// The walk goes depth first over the visible faces and round the edges of each face in order, so
+	// the horizon edges are met in order going round the eye's view counter clockwise
+	void findHorizon(const HullPoints3D& points, uint32_t face, uint32_t eye)
+	{
+		_visibleFaces.clear();
+		_horizon.clear();
+		_walk.clear();
+
+		_faces[face]._visitStamp = _stamp;
+		_faces[face]._visible = true;
+		_visibleFaces.push_back(face);
+		_walk.push_back({ 3 * face, 3 });
+		while (_walk.empty() == false)
+		{
+			WalkStep& step = _walk.back();
+			if (step._edgesLeft == 0)
+			{
+				_walk.pop_back();
+				continue;
+			}
+			uint32_t edge = step._edge;
+			step._edge = getNext(edge);
+			step._edgesLeft--;
+
+			uint32_t twin = _twins[edge];
+			uint32_t neighbor = twin / 3;
+			Face& neighborFace = _faces[neighbor];
+			if (neighborFace._visitStamp != _stamp)
+			{
+				neighborFace._visitStamp = _stamp;
+				neighborFace._visible = height(points, neighbor, eye) > 0.0;
+				if (neighborFace._visible)
+				{
+					// Its edge back to this face is already done
+					_visibleFaces.push_back(neighbor);
+					_walk.push_back({ getNext(twin), 2 });
+					continue;
+				}
+			}
+			if (neighborFace._visible == false)
+				_horizon.push_back(edge);
+		}
+	}
+
+	// Makes the output faces. Triangles in the same plane as a neighbor are put in one group and
+	// the outline of each group, the half-edges between it and other groups, is walked for its vertices
+	void mergeFaces(const HullPoints3D& points)
+	{
+		uint32_t faceCount = uint32_t(_faces.size());
+		_group.resize(faceCount);
+		for (uint32_t face = 0; face < faceCount; face++)
+			_group[face] = face;
+		for (uint32_t face = 0; face < faceCount; face++)
+		{
+			if (_faces[face]._removed)
+				continue;
+			for (uint32_t edge = 3 * face; edge < 3 * face + 3; edge++)
+			{
+				uint32_t twin = _twins[edge];
+				uint32_t neighbor = twin / 3;
+				if (neighbor < face)
+					continue; // Done from the other side
+				uint32_t opposite = _faces[neighbor]._vertex[(twin % 3 + 2) % 3];
+				if (height(points, face, opposite) == 0.0)
+					_group[findGroup(face)] = findGroup(neighbor);
+			}
+		}
+		for (uint32_t face = 0; face < faceCount; face++)
+			_group[face] = findGroup(face);
+
+		_edgeDone.assign(_twins.size(), 0);
+		for (uint32_t face = 0; face < faceCount; face++)
+		{
+			if (_faces[face]._removed)
+				continue;
+			for (uint32_t first = 3 * face; first < 3 * face + 3; first++)
+			{
+				if (_edgeDone[first] || _group[_twins[first] / 3] == _group[face])
+					continue;
+
+				// The next outline edge starts where this one ends, the triangles of the group round
+				// that vertex are crossed until an edge leaves the group
+				size_t start = _faceVertices.size();
+				uint32_t edge = first;
+				do
+				{
+					_edgeDone[edge] = 1;
+					_faceVertices.push_back(getFrom(edge));
+					uint32_t next = getNext(edge);
+					while (_group[_twins[next] / 3] == _group[face])
+						next = getNext(_twins[next]);
+					edge = next;
+				} while (edge != first);
+
+				removeStraightVertices(points, start);
+				_faceStarts.push_back(uint32_t(_faceVertices.size()));
+			}
+		}
+	}
+	uint32_t findGroup(uint32_t face)
+	{
+		while (_group[face] != face)
+		{
+			_group[face] = _group[_group[face]];
+			face = _group[face];
+		}
+		return face;
+	}
+	// Drops the vertices of the last face that are in line with the ones on either side. The face
+	// is flat, so this is tested in 2D on the two axes its normal is least along
+	void removeStraightVertices(const HullPoints3D& points, size_t start)
+	{
+		size_t count = _faceVertices.size() - start;
+		if (count <= 3)
+			return;
+
+		_outline.assign(_faceVertices.begin() + start, _faceVertices.end());
+		int dropped = getLargestNormalAxis(points, _outline.data(), count);
+		const float* u = dropped == 0 ? points._y.data() : points._x.data();
+		const float* v = dropped == 2 ? points._y.data() : points._z.data();
+
+		size_t kept = start;
+		for (size_t i = 0; i < count; i++)
+		{
+			uint32_t previous = _outline[(i + count - 1) % count];
+			uint32_t current = _outline[i];
+			uint32_t next = _outline[(i + 1) % count];
+			if (HullPredicates::orientation(u[previous], v[previous], u[current], v[current], u[next], v[next]) != 0.0)
+				_faceVertices[kept++] = current;
+		}
+		_faceVertices.resize(kept);
+	}
+	// Axis the normal of a flat polygon is largest along (Newell's method)
+	static int getLargestNormalAxis(const HullPoints3D& points, const uint32_t* polygon, size_t count)
+	{
+		double normal[3] = { 0.0, 0.0, 0.0 };
+		for (size_t i = 0; i < count; i++)
+		{
+			uint32_t a = polygon[i];
+			uint32_t b = polygon[(i + 1) % count];
+			normal[0] += (double(points._y[a]) - points._y[b]) * (double(points._z[a]) + points._z[b]);
+			normal[1] += (double(points._z[a]) - points._z[b]) * (double(points._x[a]) + points._x[b]);
+			normal[2] += (double(points._x[a]) - points._x[b]) * (double(points._y[a]) + points._y[b]);
+		}
+		int axis = std::fabs(normal[1]) > std::fabs(normal[0]) ? 1 : 0;
+		return std::fabs(normal[2]) > std::fabs(normal[axis]) ? 2 : axis;
+	}
+
+	// Sets the on-hull bits of the face vertices and adds each edge from the face it goes up in index in
+	void addEdges(HullPoints3D& points, std::vector<HullEdge>& edges) const
+	{
+		for (size_t face = 0; face + 1 < _faceStarts.size(); face++)
+		{
+			uint32_t start = _faceStarts[face];
+			uint32_t count = _faceStarts[face + 1] - start;
+			for (uint32_t i = 0; i < count; i++)
+			{
+				uint32_t a = _faceVertices[start + i];
+				uint32_t b = _faceVertices[start + (i + 1) % count];
+				points.setAsOnHull(a);
+				if (a < b)
+					edges.push_back({ a, b });
+			}
+		}
+	}
+	// Hull of points that are all on one plane or line, or are all the same point
+	void addFlatHull(HullPoints3D& points, const uint32_t simplex[4], int dimensions, std::vector<HullEdge>& edges)
+	{
+		points.setAsOnHull(simplex[0]);
+		if (dimensions == 0)
+			return;
+		points.setAsOnHull(simplex[1]);
+		if (dimensions == 1)
+		{
+			edges.push_back({ simplex[0], simplex[1] });
+			return;
+		}
+
+		// Projected on to the two axes the plane's normal is least along and given to the 2D hull
+		int dropped = getLargestNormalAxis(points, simplex, 3);
+		const std::vector<float>& u = dropped == 0 ? points._y : points._x;
+		const std::vector<float>& v = dropped == 2 ? points._y : points._z;
+		_flatPoints.resize(points.size());
+		for (size_t i = 0; i < points.size(); i++)
+			_flatPoints.setPoint(i, u[i], v[i]);
+		_flatEdges.clear();
+		_flatHull.computeHull(_flatPoints, _flatEdges);
+
+		const std::vector<uint32_t>& order = _flatHull.getHullOrder();
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			_faceVertices.push_back(order[i]);
+			points.setAsOnHull(order[i]);
+			edges.push_back({ order[i], order[(i + 1) % order.size()] });
+		}
+		_faceStarts.push_back(uint32_t(_faceVertices.size()));
+	}
+
+	uint32_t newFace(uint32_t a, uint32_t b, uint32_t c)
+	{
+		uint32_t face;
+		if (_freeFaces.empty() == false)
+		{
+			face = _freeFaces.back();
+			_freeFaces.pop_back();
+		}
+		else
+		{
+			face = uint32_t(_faces.size());
+			_faces.emplace_back();
+			_twins.resize(_twins.size() + 3, _none);
+		}
+		_faces[face] = Face();
+		_faces[face]._vertex[0] = a;
+		_faces[face]._vertex[1] = b;
+		_faces[face]._vertex[2] = c;
+		return face;
+	}
+	void addConflict(uint32_t face, uint32_t point, double pointHeight)
+	{
+		Face& conflictFace = _faces[face];
+		_nextConflict[point] = conflictFace._conflictHead;
+		conflictFace._conflictHead = point;
+		float size = HullPredicates::toFloat(pointHeight);
+		if (size > conflictFace._farthestHeight)
+		{
+			conflictFace._farthestHeight = size;
+			conflictFace._farthestPoint = point;
+		}
+	}
+
+	static uint32_t getNext(uint32_t edge)
+	{
+		return edge % 3 == 2 ? edge - 2 : edge + 1;
+	}
+	uint32_t getFrom(uint32_t edge) const
+	{
+		return _faces[edge / 3]._vertex[edge % 3];
+	}
+	uint32_t getTo(uint32_t edge) const
+	{
+		return _faces[edge / 3]._vertex[(edge % 3 + 1) % 3];
+	}
+
+	// Positive when the point is above the face, the exact orientation scaled by twice the face's area
+	double height(const HullPoints3D& points, uint32_t face, uint32_t point) const
+	{
+		const uint32_t* vertex = _faces[face]._vertex;
+		return height(points, vertex[0], vertex[1], vertex[2], point);
+	}
+	HullPredicates::Plane3D getPlane(const HullPoints3D& points, uint32_t face) const
+	{
+		const uint32_t* vertex = _faces[face]._vertex;
+		return HullPredicates::Plane3D(points._x[vertex[0]], points._y[vertex[0]], points._z[vertex[0]],
+			points._x[vertex[1]], points._y[vertex[1]], points._z[vertex[1]], points._x[vertex[2]], points._y[vertex[2]], points._z[vertex[2]]);
+	}
+	static double height(const HullPoints3D& points, uint32_t a, uint32_t b, uint32_t c, uint32_t point)
+	{
+		return HullPredicates::orientation3D(points._x[a], points._y[a], points._z[a], points._x[b], points._y[b], points._z[b],
+			points._x[c], points._y[c], points._z[c], points._x[point], points._y[point], points._z[point]);
+	}
+
+private:
+	// A visible face in the horizon walk, with the edges of it still to be looked across
+	struct WalkStep
+	{
+		uint32_t _edge;
+		uint32_t _edgesLeft;
+	};
+
+	std::vector<Face> _faces;
+	std::vector<uint32_t> _twins;
+	std::vector<uint32_t> _freeFaces; // Removed faces to reuse
+	std::vector<uint32_t> _pendingFaces; // Faces that had points when they were made, some may have been removed since
+	std::vector<uint32_t> _nextConflict; // Next point in the same conflict list, one for each point
+	uint32_t _stamp = 0;
+	size_t _candidateCount = 0;
+
+	// Working memory of each added point
+	std::vector<WalkStep> _walk;
+	std::vector<uint32_t> _visibleFaces;
+	std::vector<uint32_t> _horizon;
+	std::vector<uint32_t> _newFaces;
+	std::vector<HullPredicates::Plane3D> _newPlanes;
+
+	// Working memory of the output
+	std::vector<uint32_t> _group;
+	std::vector<uint8_t> _edgeDone;
+	std::vector<uint32_t> _outline;
+	HullPoints _flatPoints;
+	std::vector<HullEdge> _flatEdges;
+	MonotoneChainHull _flatHull;
+
+	// Output
+	std::vector<uint32_t> _faceVertices;
+	std::vector<uint32_t> _faceStarts;
+};
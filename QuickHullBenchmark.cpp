@@ -0,0 +1,753 @@
+// QuickHullBenchmark.cpp
+// Nathan Damon
+// 2026-10-16
+// Times the hull engines without opening a window
+//
+// Every dataset from PointDatasets is run at 10, 100, ... 10^N points from
+// fixed seeds, so runs of different builds can be compared. For each one
+// the min, median and 99th percentile times, the points per second (from
+// the median) and the heap allocations per run are printed and can be
+// written to CSV and JSON files. QuickHull3D is run on the 3D version of
+// each dataset, the ball for the disk, the sphere for the circle and so on.
+// The batch engine cuts the points into sets of 10, 100 and 1000 and times
+// BatchHull on all of them next to QuickHull run on each set on its own.
+// The scalar engine runs QuickHull on double copies of the float points
+// and on int32_t copies scaled by 2^28, with the same modes as the
+// quickhull engine.
+// The quickhull-approx engine runs QuickHull within a tolerance of 1/1024,
+// about a pixel of a 1024 pixel window, and with at most 256 hull points.
+//
+// This is its own program, build it on its own with AllocationCounter.cpp.
+// For example:
+//   g++ -O2 -std=c++17 QuickHullBenchmark.cpp AllocationCounter.cpp -o QuickHullBenchmark -pthread
+// In Visual Studio, add both files to a separate console project.
+//
+// Options:
+//   --min-exponent N   Smallest point count is 10^N (default 1)
+//   --max-exponent N   Largest point count is 10^N (default 7, 8 needs about 2GB, QuickHull3D on
+//                      the sphere datasets needs about 1GB at 7)
+//   --runs N           Timed runs per case (default depends on the point count)
+//   --dataset NAME     Only run the named dataset, can be given more than once
+//   --engine NAME      Only run the named engine (quickhull, monotone-chain, chan, dynamic, quickhull-int32, quickhull-int16,
+//                      quickhull3d, batch, scalar or quickhull-approx), can be given more than once
+//   --mode MODE        serial, parallel or both (default both), for QuickHull and batch
+//   --culling MODE     off, on or both (default both), culling of the points inside the extremes for QuickHull
+//   --seed N           Seed for the datasets (default 12345)
+//   --csv FILE         Write the results as CSV
+//   --json FILE        Write the results as JSON
+//   --verify           Check the engines against a simpler way of getting the same result instead of
+//                      timing them, on the same datasets and point counts. Takes no value
+
+#include "QuickHullSoA.h"
+#include "MonotoneChainHull.h"
+#include "ChanHull.h"
+#include "DynamicHull.h"
+#include "IntegerQuickHull.h"
+#include "QuickHull3D.h"
+#include "BatchHull.h"
+#include "PointGrid.h"
+#include "KineticHull.h"
+#include "PointDatasets.h"
+#include "AllocationCounter.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+
+// #######################################################################################################
+// Benchmark
+// #######################################################################################################
+
+class QuickHullBenchmark
+{
+public:
+	struct Result
+	{
+		std::string _engine;
+		std::string _dataset;
+		size_t _pointCount = 0;
+		size_t _runs = 0;
+		double _minMilliseconds = 0.0;
+		double _medianMilliseconds = 0.0;
+		double _p99Milliseconds = 0.0;
+		double _pointsPerSecond = 0.0;
+		double _allocationsPerRun = 0.0;
+		size_t _candidateCount = 0;
+		size_t _hullPointCount = 0;
+	};
+
+public:
+	QuickHullBenchmark() {}
+	~QuickHullBenchmark() {}
+
+	// Returns false when the options could not be read
+	bool readOptions(int argc, char** argv)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			std::string option = argv[i];
+			if (option == "--verify")
+			{
+				_verify = true;
+				continue;
+			}
+			if (i + 1 >= argc)
+			{
+				std::cout << "Missing value for " << option << std::endl;
+				return false;
+			}
+			std::string value = argv[++i];
+
+			if (option == "--min-exponent")
+				_minExponent = std::atoi(value.c_str());
+			else if (option == "--max-exponent")
+				_maxExponent = std::atoi(value.c_str());
+			else if (option == "--runs")
+				_runs = size_t(std::atoll(value.c_str()));
+			else if (option == "--seed")
+				_seed = uint64_t(std::strtoull(value.c_str(), nullptr, 10));
+			else if (option == "--csv")
+				_csvFile = value;
+			else if (option == "--json")
+				_jsonFile = value;
+			else if (option == "--mode")
+			{
+				if (value != "serial" && value != "parallel" && value != "both")
+				{
+					std::cout << "Unknown mode " << value << std::endl;
+					return false;
+				}
+				_mode = value;
+			}
+			else if (option == "--culling")
+			{
+				if (value != "off" && value != "on" && value != "both")
+				{
+					std::cout << "Unknown culling mode " << value << std::endl;
+					return false;
+				}
+				_culling = value;
+			}
+			else if (option == "--engine")
+			{
+				if (value != "quickhull" && value != "monotone-chain" && value != "chan" && value != "dynamic"
+					&& value != "quickhull-int32" && value != "quickhull-int16" && value != "quickhull3d" && value != "batch" && value != "scalar"
+					&& value != "quickhull-approx")
+				{
+					std::cout << "Unknown engine " << value << std::endl;
+					return false;
+				}
+				_engines.push_back(value);
+			}
+			else if (option == "--dataset")
+			{
+				PointDatasets::Dataset dataset;
+				if (PointDatasets::getDataset(value, dataset) == false)
+				{
+					std::cout << "Unknown dataset " << value << std::endl;
+					return false;
+				}
+				_datasets.push_back(dataset);
+			}
+			else
+			{
+				std::cout << "Unknown option " << option << std::endl;
+				return false;
+			}
+		}
+
+		if (_minExponent < 1 || _maxExponent > 9 || _minExponent > _maxExponent)
+		{
+			std::cout << "Exponents must be between 1 and 9 with the min not above the max" << std::endl;
+			return false;
+		}
+		if (_datasets.empty())
+		{
+			for (int i = 0; i < static_cast<int>(PointDatasets::Dataset::Count); i++)
+				_datasets.push_back(static_cast<PointDatasets::Dataset>(i));
+		}
+		if (_engines.empty())
+			_engines = { "quickhull", "monotone-chain", "chan", "dynamic", "quickhull-int32", "quickhull-int16", "quickhull3d", "batch", "scalar", "quickhull-approx" };
+		return true;
+	}
+
+	// Returns false when a check failed
+	bool run()
+	{
+		if (_verify)
+			return verify();
+
+		std::cout << "Hull kernels: " << HullKernels::getName() << "\n";
+		std::cout << "Threads: " << TaskPool::getInstance().getThreadCount() << "\n\n";
+
+		HullPoints points;
+		HullPoints3D points3D;
+		for (auto dataset : _datasets)
+		{
+			size_t pointCount = 1;
+			for (int i = 0; i < _minExponent; i++)
+				pointCount *= 10;
+
+			for (int exponent = _minExponent; exponent <= _maxExponent; exponent++, pointCount *= 10)
+			{
+				points.resize(pointCount);
+				PointDatasets::generate(dataset, points, _seed);
+
+				// Every engine on the same points, so the results sit next to each other
+				for (auto& engine : _engines)
+				{
+					if (engine == "monotone-chain")
+						_results.push_back(timeEngine(_monotoneChain, points, dataset));
+					else if (engine == "chan")
+						_results.push_back(timeEngine(_chan, points, dataset));
+					else if (engine == "dynamic")
+						_results.push_back(timeEngine(_dynamicHull, points, dataset));
+					else if (engine == "quickhull-int32")
+						_results.push_back(timeEngine(_quickHullInt32, points, dataset));
+					else if (engine == "quickhull-int16")
+						_results.push_back(timeEngine(_quickHullInt16, points, dataset));
+					else if (engine == "quickhull3d")
+					{
+						points3D.resize(pointCount);
+						PointDatasets::generate(dataset, points3D, _seed);
+						_results.push_back(timeEngine(_quickHull3D, points3D, dataset));
+					}
+					else if (engine == "batch")
+						timeBatch(points, dataset);
+					else if (engine == "scalar")
+						timeScalar(points, dataset);
+					else if (engine == "quickhull-approx")
+						timeApproximateQuickHull(points, dataset);
+					else
+						timeQuickHull(_quickHull, points, dataset);
+				}
+			}
+		}
+
+		printResults();
+		if (_csvFile.empty() == false)
+			writeCSV(_csvFile);
+		if (_jsonFile.empty() == false)
+			writeJSON(_jsonFile);
+		return true;
+	}
+
+private:
+	// Runs every check on every dataset and point count, prints the ones that fail
+	bool verify()
+	{
+		std::cout << "Hull kernels: " << HullKernels::getName() << "\n";
+		std::cout << "Threads: " << TaskPool::getInstance().getThreadCount() << "\n\n";
+
+		HullPoints points;
+		for (auto dataset : _datasets)
+		{
+			size_t pointCount = 1;
+			for (int i = 0; i < _minExponent; i++)
+				pointCount *= 10;
+
+			for (int exponent = _minExponent; exponent <= _maxExponent; exponent++, pointCount *= 10)
+			{
+				points.resize(pointCount);
+				PointDatasets::generate(dataset, points, _seed);
+				verifyBatch(points, dataset);
+				verifyGrid(points, dataset);
+				verifyKinetic(points, dataset);
+			}
+		}
+
+		std::cout << _checkCount - _failedCheckCount << " of " << _checkCount << " checks passed" << std::endl;
+		return _failedCheckCount == 0;
+	}
+
+	// BatchHull against MonotoneChainHull run on each set on its own
+	void verifyBatch(const HullPoints& points, PointDatasets::Dataset dataset)
+	{
+		std::vector<HullEdge> edges;
+		std::vector<uint32_t> expected;
+		std::vector<uint32_t> found;
+		for (size_t setSize : { size_t(10), size_t(100), size_t(1000) })
+		{
+			if (setSize > points.size())
+				continue;
+			_batchOffsets.clear();
+			for (size_t offset = 0; offset < points.size(); offset += setSize)
+				_batchOffsets.push_back(uint32_t(offset));
+			_batchOffsets.push_back(uint32_t(points.size()));
+
+			for (int parallel = 0; parallel < 2; parallel++)
+			{
+				_batchHull.setParallel(parallel == 1);
+				_batchHull.computeHulls(points, _batchOffsets);
+
+				size_t wrongSets = 0;
+				for (size_t s = 0; s + 1 < _batchOffsets.size(); s++)
+				{
+					_setPoints.resize(_batchOffsets[s + 1] - _batchOffsets[s]);
+					for (size_t i = 0; i < _setPoints.size(); i++)
+						_setPoints.setPoint(i, points._x[_batchOffsets[s] + i], points._y[_batchOffsets[s] + i]);
+					edges.clear();
+					_monotoneChain.computeHull(_setPoints, edges);
+
+					expected.clear();
+					for (uint32_t index : _monotoneChain.getHullOrder())
+						expected.push_back(_batchOffsets[s] + index);
+					const std::vector<uint32_t>& offsets = _batchHull.getHullOffsets();
+					found.assign(_batchHull.getHullIndices().begin() + offsets[s], _batchHull.getHullIndices().begin() + offsets[s + 1]);
+					wrongSets += isSameCycle(expected, found) ? 0 : 1;
+				}
+				reportCheck(wrongSets == 0, "BatchHull sets of " + std::to_string(setSize) + (parallel == 1 ? " (parallel)" : " (serial)"),
+					dataset, points.size(), std::to_string(wrongSets) + " sets differ from MonotoneChain");
+			}
+		}
+	}
+
+	// PointGrid's queries against looking at every point, after a build and after moving some points
+	void verifyGrid(const HullPoints& points, PointDatasets::Dataset dataset)
+	{
+		_gridPoints = points;
+		_pointGrid.build(_gridPoints);
+		reportCheck(countWrongGridQueries() == 0, "PointGrid build", dataset, points.size(), "queries differ from looking at every point");
+
+		// Every 16th point moves a little, which update can mostly take without building again
+		for (size_t i = 0; i < _gridPoints.size(); i += 16)
+			_gridPoints.setPoint(i, _gridPoints._x[i] + 0.003f, _gridPoints._y[i] - 0.002f);
+		_pointGrid.update(_gridPoints);
+		reportCheck(countWrongGridQueries() == 0, "PointGrid update", dataset, points.size(), "queries differ from looking at every point");
+	}
+	// Runs each query around spots spread over the points, returns how many came out wrong
+	size_t countWrongGridQueries()
+	{
+		const HullPoints& points = _gridPoints;
+		size_t n = points.size();
+		const size_t spotCount = 64;
+		const float epsilon = 0.01f;
+		size_t wrong = 0;
+		std::vector<uint32_t> found;
+		std::vector<uint32_t> expected;
+		for (size_t k = 0; k < spotCount; k++)
+		{
+			// Spots near the points, a few of them off the grid
+			size_t near = k * (n - 1) / (spotCount - 1);
+			float x = points._x[near] + 0.02f * float(int(k % 5) - 2);
+			float y = points._y[near] + 0.02f * float(int(k % 3) - 1) + (k % 16 == 0 ? 2.0f : 0.0f);
+			size_t other = (near + n / 2) % n;
+
+			// The nearest point may be any of the ones at the least distance
+			bool evenOnly = k % 2 == 1;
+			uint32_t nearest = _pointGrid.findNearest(points, x, y, [evenOnly](uint32_t index) { return evenOnly == false || index % 2 == 0; });
+			float nearestDistance = std::numeric_limits<float>::max();
+			for (size_t i = 0; i < n; i++)
+			{
+				if (evenOnly && i % 2 == 1)
+					continue;
+				float dx = points._x[i] - x;
+				float dy = points._y[i] - y;
+				nearestDistance = std::min(nearestDistance, dx * dx + dy * dy);
+			}
+			if (nearest == PointGrid::noPoint)
+				wrong += nearestDistance < std::numeric_limits<float>::max() ? 1 : 0;
+			else
+			{
+				float dx = points._x[nearest] - x;
+				float dy = points._y[nearest] - y;
+				wrong += dx * dx + dy * dy == nearestDistance ? 0 : 1;
+			}
+
+			found.clear();
+			expected.clear();
+			float x0 = x - 0.05f;
+			float y0 = y - 0.03f;
+			float x1 = x + 0.04f;
+			float y1 = y + 0.06f;
+			_pointGrid.findInRect(points, x1, y1, x0, y0, found);
+			for (size_t i = 0; i < n; i++)
+			{
+				if (points._x[i] >= x0 && points._x[i] <= x1 && points._y[i] >= y0 && points._y[i] <= y1)
+					expected.push_back(uint32_t(i));
+			}
+			std::sort(found.begin(), found.end());
+			wrong += found == expected ? 0 : 1;
+
+			// The same distance to the segment as findNearSegment works out, so the edge cases agree
+			found.clear();
+			expected.clear();
+			float ax = x;
+			float ay = y;
+			float bx = points._x[other];
+			float by = points._y[other];
+			_pointGrid.findNearSegment(points, ax, ay, bx, by, epsilon, found);
+			float dx = bx - ax;
+			float dy = by - ay;
+			float lengthSquared = dx * dx + dy * dy;
+			for (size_t i = 0; i < n; i++)
+			{
+				float px = points._x[i] - ax;
+				float py = points._y[i] - ay;
+				float t = lengthSquared > 0.0f ? std::min(1.0f, std::max(0.0f, (px * dx + py * dy) / lengthSquared)) : 0.0f;
+				float offsetX = px - t * dx;
+				float offsetY = py - t * dy;
+				if (offsetX * offsetX + offsetY * offsetY <= epsilon * epsilon)
+					expected.push_back(uint32_t(i));
+			}
+			std::sort(found.begin(), found.end());
+			wrong += found == expected ? 0 : 1;
+		}
+		return wrong;
+	}
+
+	// KineticHull::update against a full QuickHull on the same points, over enough frames of drift for a few rebuilds
+	void verifyKinetic(const HullPoints& points, PointDatasets::Dataset dataset)
+	{
+		const float maxMove = 0.001f;
+		const size_t frameCount = 24;
+		_kineticPoints = points;
+		_kineticVelocities.resize(2 * points.size());
+		for (size_t i = 0; i < points.size(); i++)
+		{
+			// A little under maxMove, so the rounding of the moved points stays inside it
+			uint32_t random[4];
+			PhiloxRandom::generateBlock(_seed, _velocityStream, i, random);
+			float angle = float(random[0]) * (6.28318531f / 4294967296.0f);
+			_kineticVelocities[2 * i] = 0.99f * maxMove * std::cos(angle);
+			_kineticVelocities[2 * i + 1] = 0.99f * maxMove * std::sin(angle);
+		}
+
+		std::vector<HullEdge> edges;
+		_kineticHull.computeHull(_kineticPoints, edges);
+		size_t wrongFrames = 0;
+		for (size_t frame = 0; frame < frameCount; frame++)
+		{
+			for (size_t i = 0; i < _kineticPoints.size(); i++)
+				_kineticPoints.setPoint(i, _kineticPoints._x[i] + _kineticVelocities[2 * i], _kineticPoints._y[i] + _kineticVelocities[2 * i + 1]);
+			edges.clear();
+			_kineticHull.update(_kineticPoints, maxMove, edges);
+			std::vector<uint32_t> found = _kineticHull.getHullOrder();
+
+			edges.clear();
+			_quickHull.setParallel(false);
+			_quickHull.setCulling(false);
+			_quickHull.computeHull(_kineticPoints, edges);
+			wrongFrames += isSameCycle(_quickHull.getHullOrder(), found) ? 0 : 1;
+		}
+		reportCheck(wrongFrames == 0, "KineticHull update", dataset, points.size(),
+			std::to_string(wrongFrames) + " of " + std::to_string(frameCount) + " frames differ from a full QuickHull");
+	}
+
+	// True when found is expected, starting from any of its points
+	static bool isSameCycle(const std::vector<uint32_t>& expected, const std::vector<uint32_t>& found)
+	{
+		if (expected.size() != found.size())
+			return false;
+		if (expected.empty())
+			return true;
+		auto start = std::find(found.begin(), found.end(), expected[0]);
+		if (start == found.end())
+			return false;
+		size_t offset = size_t(start - found.begin());
+		for (size_t i = 0; i < expected.size(); i++)
+		{
+			if (expected[i] != found[(offset + i) % found.size()])
+				return false;
+		}
+		return true;
+	}
+
+	void reportCheck(bool passed, const std::string& check, PointDatasets::Dataset dataset, size_t pointCount, const std::string& failure)
+	{
+		_checkCount++;
+		if (passed)
+			return;
+		_failedCheckCount++;
+		std::cout << "Failed: " << check << " on " << PointDatasets::getName(dataset) << " with " << pointCount << " points, " << failure << std::endl;
+	}
+
+	// Every mode and culling setting that was asked for
+	template <typename Scalar>
+	void timeQuickHull(BasicQuickHullSoA<Scalar>& quickHull, BasicHullPoints<Scalar>& points, PointDatasets::Dataset dataset)
+	{
+		for (int culling = 0; culling < 2; culling++)
+		{
+			if ((culling == 0 && _culling == "on") || (culling == 1 && _culling == "off"))
+				continue;
+			for (int parallel = 0; parallel < 2; parallel++)
+			{
+				if ((parallel == 0 && _mode == "parallel") || (parallel == 1 && _mode == "serial"))
+					continue;
+				quickHull.setParallel(parallel == 1);
+				quickHull.setCulling(culling == 1);
+				_results.push_back(timeEngine(quickHull, points, dataset));
+			}
+		}
+	}
+
+	// Serial QuickHull with each way of approximating, the error is not printed
+	void timeApproximateQuickHull(HullPoints& points, PointDatasets::Dataset dataset)
+	{
+		_quickHull.setParallel(false);
+		_quickHull.setCulling(true);
+		_quickHull.setTolerance(1.0f / 1024.0f);
+		_results.push_back(timeEngine(_quickHull, points, dataset));
+		_quickHull.setTolerance(0.0f);
+		_quickHull.setMaxVertexCount(256);
+		_results.push_back(timeEngine(_quickHull, points, dataset));
+		_quickHull.setMaxVertexCount(0);
+	}
+
+	// Sets of 10, 100 and 1000 points, as many as fit in points
+	void timeBatch(const HullPoints& points, PointDatasets::Dataset dataset)
+	{
+		for (size_t setSize : { size_t(10), size_t(100), size_t(1000) })
+		{
+			if (setSize > points.size())
+				continue;
+			_batchOffsets.clear();
+			for (size_t offset = 0; offset < points.size(); offset += setSize)
+				_batchOffsets.push_back(uint32_t(offset));
+			_batchOffsets.push_back(uint32_t(points.size()));
+
+			for (int parallel = 0; parallel < 2; parallel++)
+			{
+				if ((parallel == 0 && _mode == "parallel") || (parallel == 1 && _mode == "serial"))
+					continue;
+				_batchHull.setParallel(parallel == 1);
+				Result result = timeRuns(points.size(), [&]() { _batchHull.computeHulls(points, _batchOffsets); });
+				result._engine = std::string("Batch of ") + std::to_string(setSize) + (parallel == 1 ? " (parallel)" : " (serial)");
+				result._dataset = PointDatasets::getName(dataset);
+				result._candidateCount = points.size();
+				result._hullPointCount = _batchHull.getHullIndices().size();
+				_results.push_back(result);
+			}
+
+			// What the batch saves, a copy of each set and a run of its own
+			std::vector<HullEdge> edges;
+			Result result = timeRuns(points.size(), [&]()
+				{
+					for (size_t s = 0; s + 1 < _batchOffsets.size(); s++)
+					{
+						_setPoints.resize(_batchOffsets[s + 1] - _batchOffsets[s]);
+						for (size_t i = 0; i < _setPoints.size(); i++)
+							_setPoints.setPoint(i, points._x[_batchOffsets[s] + i], points._y[_batchOffsets[s] + i]);
+						edges.clear();
+						_setQuickHull.computeHull(_setPoints, edges);
+					}
+				});
+			result._engine = std::string("QuickHullSoA per set of ") + std::to_string(setSize);
+			result._dataset = PointDatasets::getName(dataset);
+			result._candidateCount = points.size();
+			result._hullPointCount = _batchHull.getHullIndices().size();
+			_results.push_back(result);
+		}
+	}
+
+	// The same QuickHull on double and int32_t copies of the points, the quickhull engine times the floats
+	void timeScalar(HullPoints& points, PointDatasets::Dataset dataset)
+	{
+		_doublePoints.resize(points.size());
+		_int32Points.resize(points.size());
+		for (size_t i = 0; i < points.size(); i++)
+		{
+			_doublePoints.setPoint(i, points._x[i], points._y[i]);
+			_int32Points.setPoint(i, int32_t(std::lround(double(points._x[i]) * _int32Scale)), int32_t(std::lround(double(points._y[i]) * _int32Scale)));
+		}
+		timeQuickHull(_quickHullDouble, _doublePoints, dataset);
+		timeQuickHull(_quickHullInt32Points, _int32Points, dataset);
+	}
+
+	// Times run, the first run sizes the buffers and is not counted
+	// Fills in the times, points per second and allocations of the result
+	template <typename Function>
+	Result timeRuns(size_t pointCount, Function&& run)
+	{
+		// Fewer runs for the larger point counts
+		size_t runs = _runs;
+		if (runs == 0)
+			runs = std::max(size_t(5), std::min(size_t(1000), size_t(10000000) / pointCount));
+
+		run();
+
+		std::vector<double> times(runs);
+		size_t allocationsAtStart = AllocationCounter::getCount();
+		for (size_t i = 0; i < runs; i++)
+		{
+			auto timeStart = std::chrono::steady_clock::now();
+			run();
+			std::chrono::duration<double> timeTaken = std::chrono::steady_clock::now() - timeStart;
+			times[i] = timeTaken.count() * 1000.0;
+		}
+		size_t allocations = AllocationCounter::getCount() - allocationsAtStart;
+		std::sort(times.begin(), times.end());
+
+		Result result;
+		result._pointCount = pointCount;
+		result._runs = runs;
+		result._minMilliseconds = times.front();
+		result._medianMilliseconds = times[runs / 2];
+		result._p99Milliseconds = times[std::min(runs - 1, size_t(std::ceil(runs * 0.99)) - 1)];
+		result._pointsPerSecond = result._medianMilliseconds > 0.0 ? double(pointCount) / (result._medianMilliseconds / 1000.0) : 0.0;
+		result._allocationsPerRun = double(allocations) / double(runs);
+		return result;
+	}
+
+	// Engine is a HullEngine with HullPoints, QuickHull3D with HullPoints3D or a BasicQuickHullSoA with its points
+	template <typename Engine, typename Points>
+	Result timeEngine(Engine& engine, Points& points, PointDatasets::Dataset dataset)
+	{
+		std::vector<HullEdge> edges;
+		edges.reserve(points.size());
+		Result result = timeRuns(points.size(), [&]()
+			{
+				edges.clear();
+				engine.computeHull(points, edges);
+			});
+		result._engine = engine.getName();
+		result._dataset = PointDatasets::getName(dataset);
+		result._candidateCount = getCandidateCount(engine, points.size());
+		for (size_t i = 0; i < points.size(); i++)
+			result._hullPointCount += points.isOnHull(i) ? 1 : 0;
+		return result;
+	}
+
+	// Only the QuickHulls cull, the other engines look at every point
+	size_t getCandidateCount(HullEngine& engine, size_t pointCount) const
+	{
+		(void)engine;
+		return pointCount;
+	}
+	template <typename Scalar>
+	size_t getCandidateCount(BasicQuickHullSoA<Scalar>& engine, size_t pointCount) const
+	{
+		(void)pointCount;
+		return engine.getCandidateCount();
+	}
+	size_t getCandidateCount(QuickHull3D& engine, size_t pointCount) const
+	{
+		(void)pointCount;
+		return engine.getCandidateCount();
+	}
+
+	// The engine column is as wide as the longest engine name
+	void printResults()
+	{
+		size_t engineWidth = std::string("Engine").size();
+		for (auto& result : _results)
+			engineWidth = std::max(engineWidth, result._engine.size());
+		engineWidth += 2;
+
+		std::cout << std::left << std::setw(int(engineWidth)) << "Engine" << std::setw(16) << "Dataset" << std::right
+			<< std::setw(11) << "Points" << std::setw(7) << "Runs"
+			<< std::setw(12) << "Min ms" << std::setw(12) << "Median ms" << std::setw(12) << "P99 ms"
+			<< std::setw(14) << "Points/s" << std::setw(10) << "Allocs" << std::setw(11) << "Candidates" << std::setw(10) << "Hull" << "\n";
+		std::cout << std::setw(int(engineWidth) + 115) << std::setfill('-') << "-" << std::setfill(' ') << std::endl;
+		for (auto& result : _results)
+		{
+			std::cout << std::left << std::setw(int(engineWidth)) << result._engine << std::setw(16) << result._dataset << std::right
+				<< std::setw(11) << result._pointCount << std::setw(7) << result._runs << std::fixed << std::setprecision(4)
+				<< std::setw(12) << result._minMilliseconds << std::setw(12) << result._medianMilliseconds << std::setw(12) << result._p99Milliseconds
+				<< std::setprecision(0) << std::setw(14) << result._pointsPerSecond << std::setprecision(1) << std::setw(10) << result._allocationsPerRun
+				<< std::setw(11) << result._candidateCount << std::setw(10) << result._hullPointCount << std::defaultfloat << std::endl;
+		}
+	}
+
+	void writeCSV(const std::string& fileName)
+	{
+		std::ofstream out(fileName);
+		if (out.is_open() == false)
+		{
+			std::cout << "Could not open " << fileName << std::endl;
+			return;
+		}
+		out << "engine,dataset,points,runs,min_ms,median_ms,p99_ms,points_per_second,allocations_per_run,candidates,hull_points\n";
+		out << std::setprecision(9);
+		for (auto& result : _results)
+		{
+			out << result._engine << ',' << result._dataset << ',' << result._pointCount << ',' << result._runs << ','
+				<< result._minMilliseconds << ',' << result._medianMilliseconds << ',' << result._p99Milliseconds << ','
+				<< result._pointsPerSecond << ',' << result._allocationsPerRun << ',' << result._candidateCount << ',' << result._hullPointCount << '\n';
+		}
+		std::cout << "Results written to " << fileName << std::endl;
+	}
+	void writeJSON(const std::string& fileName)
+	{
+		std::ofstream out(fileName);
+		if (out.is_open() == false)
+		{
+			std::cout << "Could not open " << fileName << std::endl;
+			return;
+		}
+		out << std::setprecision(9);
+		out << "{\n  \"kernels\": \"" << HullKernels::getName() << "\",\n";
+		out << "  \"threads\": " << TaskPool::getInstance().getThreadCount() << ",\n";
+		out << "  \"seed\": " << _seed << ",\n";
+		out << "  \"results\": [\n";
+		for (size_t i = 0; i < _results.size(); i++)
+		{
+			const Result& result = _results[i];
+			out << "    { \"engine\": \"" << result._engine << "\", \"dataset\": \"" << result._dataset << "\""
+				<< ", \"points\": " << result._pointCount << ", \"runs\": " << result._runs
+				<< ", \"min_ms\": " << result._minMilliseconds << ", \"median_ms\": " << result._medianMilliseconds
+				<< ", \"p99_ms\": " << result._p99Milliseconds << ", \"points_per_second\": " << result._pointsPerSecond
+				<< ", \"allocations_per_run\": " << result._allocationsPerRun << ", \"candidates\": " << result._candidateCount << ", \"hull_points\": " << result._hullPointCount << " }"
+				<< (i + 1 < _results.size() ? "," : "") << "\n";
+		}
+		out << "  ]\n}\n";
+		std::cout << "Results written to " << fileName << std::endl;
+	}
+
+private:
+	int _minExponent = 1;
+	int _maxExponent = 7;
+	size_t _runs = 0; // 0 picks the number of runs from the point count
+	uint64_t _seed = 12345;
+	std::string _mode = "both";
+	std::string _culling = "both";
+	std::string _csvFile;
+	std::string _jsonFile;
+	std::vector<PointDatasets::Dataset> _datasets;
+	std::vector<std::string> _engines;
+	bool _verify = false;
+	size_t _checkCount = 0;
+	size_t _failedCheckCount = 0;
+
+	QuickHullSoA _quickHull;
+	MonotoneChainHull _monotoneChain;
+	ChanHull _chan;
+	DynamicHull _dynamicHull;
+	IntegerQuickHull<int32_t> _quickHullInt32;
+	IntegerQuickHull<int16_t> _quickHullInt16;
+	QuickHull3D _quickHull3D;
+
+	BatchHull _batchHull;
+	std::vector<uint32_t> _batchOffsets;
+	QuickHullSoA _setQuickHull;
+	HullPoints _setPoints;
+
+	PointGrid _pointGrid;
+	HullPoints _gridPoints;
+
+	KineticHull _kineticHull;
+	HullPoints _kineticPoints;
+	std::vector<float> _kineticVelocities; // x and y of each point's move a frame
+	uint32_t _velocityStream = 8; // Stream of the seed the velocities come from, past the ones the datasets use
+
+	// The datasets fit in a few units, so this keeps them well inside int32_t
+	static constexpr double _int32Scale = double(1 << 28);
+	BasicQuickHullSoA<double> _quickHullDouble;
+	BasicQuickHullSoA<int32_t> _quickHullInt32Points;
+	BasicHullPoints<double> _doublePoints;
+	BasicHullPoints<int32_t> _int32Points;
+
+	std::vector<Result> _results;
+};
+
+int main(int argc, char** argv)
+{
+	QuickHullBenchmark benchmark;
+	if (benchmark.readOptions(argc, argv) == false)
+		return 1;
+
+	return benchmark.run() ? 0 : 1;
+}
@@ -0,0 +1,865 @@
+// QuickHullSoA.h
+// Nathan Damon
+// 2026-10-16
+// A QuickHull algorithm that works on structure-of-arrays points
+//
+// Same algorithm as the one in Main.cpp, but the points are read from the
+// contiguous x and y arrays of HullPoints and the working buffer holds
+// copies of the coordinates next to the original point index. The hull
+// passes never touch render data or follow pointers, and the results are
+// written as hull bits and point index pairs for the render side to use
+// afterwards.
+//
+// The hull comes out in counter clockwise order without sorting. Every
+// range has a run of output slots as long as the range, and a split puts
+// its new point C in the slot after the ones given to the A-C side and
+// before the ones given to the C-B side. Each hull point is a C of exactly
+// one split, so reading the used slots in order walks the hull.
+//
+// There is only one working buffer. Each range is split in place so the
+// points above A-C end up at the front of the range followed by the points
+// above C-B. The points inside the triangle are never looked at again, so
+// their slots are reused. The buffer is kept between runs, so re-running
+// on the same number of points does not allocate.
+//
+// The splitting is done by HullKernels, which also finds the farthest point
+// above each new line in the same pass.
+//
+// With culling on, the points strictly inside the polygon between the
+// extreme points are thrown out before the first split (Akl-Toussaint).
+// The least and greatest x, y, x + y and x - y points are used, since the
+// quadrilateral of only the x and y extremes still keeps half of a uniform
+// square. In serial mode this is done in the min/max scan itself against
+// the extremes found so far, which is also where the points are copied to
+// the buffer. In parallel mode the polygon of the final extremes is tested
+// in the split passes.
+//
+// In parallel mode the first min/max scan and the first split are run in
+// chunks on the TaskPool, and every range that is still large after a split
+// has its larger side handed to the pool as a task. Ranges under the serial
+// threshold are run the same way as in serial mode.
+//
+// The ranges left to split are kept on a small fixed size stack rather than
+// recursed into, so the circle case with every point on the hull does not
+// go a call deeper for each hull point.
+//
+// The hull can also be approximated. With a tolerance, a range is not split
+// once its farthest point is within the tolerance of its line, since every
+// point of the range is at least that close. With a vertex count, the
+// ranges wait in a heap and the one with the farthest point is split next
+// until the hull has that many points. Either way the error, the greatest
+// distance from the hull to a point outside it, is known from the ranges
+// that were left, and the circle case stops after as many splits as the
+// screen can show instead of one per point.
+//
+// The engine is a template over the coordinate type of the points, with
+// ScalarPredicates giving the orientation test of each one when it is
+// compiled. QuickHullSoA is the float version. The double and int32_t
+// versions have every mode above, but split with the scalar kernel since
+// the vector ones are written for float.
+
+#pragma once
+#include "HullEngine.h"
+#include "HullKernels.h"
+#include "TaskPool.h"
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+
+template <typename Scalar>
+class BasicQuickHullSoA : public BasicHullEngine<Scalar>
+{
+	static_assert(std::is_same<Scalar, float>::value || std::is_same<Scalar, double>::value || std::is_same<Scalar, int32_t>::value,
+		"Coordinates are float, double or int32_t");
+
+public:
+	using Points = BasicHullPoints<Scalar>;
+	using Predicates = ScalarPredicates<Scalar>;
+	using Line = BasicHullLine<Scalar>;
+	using Side = typename Line::Side;
+	using SplitResult = HullKernels::SplitResult;
+
+protected:
+	using BasicHullEngine<Scalar>::_hullOrder;
+	using BasicHullEngine<Scalar>::_progressQueue;
+	using BasicHullEngine<Scalar>::_profiler;
+	using BasicHullEngine<Scalar>::addHullEdges;
+	using BasicHullEngine<Scalar>::addProgressEdge;
+
+public:
+
+	// Working copy of a set of points
+	struct Buffer
+	{
+		std::vector<Scalar> _x;
+		std::vector<Scalar> _y;
+		std::vector<uint32_t> _index;
+
+		void resize(size_t count)
+		{
+			_x.resize(count);
+			_y.resize(count);
+			_index.resize(count);
+		}
+	};
+
+	// Points with the least and greatest x, y, x + y and x - y values
+	struct Extremes
+	{
+		uint32_t _left = 0;
+		uint32_t _right = 0;
+		uint32_t _bottom = 0;
+		uint32_t _top = 0;
+		uint32_t _leastSum = 0;
+		uint32_t _greatestSum = 0;
+		uint32_t _leastDifference = 0;
+		uint32_t _greatestDifference = 0;
+	};
+	// Polygon between the extremes, going around the same way as the hull
+	// Points strictly inside it can not be on the hull
+	struct CullPolygon
+	{
+		CullPolygon(const Points& points, const Extremes& extremes)
+		{
+			const uint32_t corners[8] = { extremes._left, extremes._leastSum, extremes._bottom, extremes._greatestDifference,
+				extremes._right, extremes._greatestSum, extremes._top, extremes._leastDifference };
+
+			// A point can be more than one extreme, a line from a point to itself is left out
+			for (int i = 0; i < 8; i++)
+			{
+				uint32_t from = corners[i];
+				uint32_t to = corners[(i + 1) % 8];
+				if (points._x[from] != points._x[to] || points._y[from] != points._y[to])
+					_lines[_lineCount++] = getLine(points, from, to);
+			}
+		}
+
+		bool contains(Scalar px, Scalar py) const
+		{
+			if (_lineCount < 3)
+				return false; // No area
+			for (int i = 0; i < _lineCount; i++)
+			{
+				if (_lines[i].side(px, py) >= 0)
+					return false;
+			}
+			return true;
+		}
+
+		Line _lines[8];
+		int _lineCount = 0;
+	};
+
+public:
+	BasicQuickHullSoA() {}
+	~BasicQuickHullSoA() {}
+
+	void setParallel(bool parallel)
+	{
+		_parallel = parallel;
+	}
+	bool isParallel() const
+	{
+		return _parallel;
+	}
+	void setCulling(bool culling)
+	{
+		_culling = culling;
+	}
+	bool isCulling() const
+	{
+		return _culling;
+	}
+	// Ranges whose farthest point is within tolerance of their line are not split, 0 for the exact hull
+	void setTolerance(float tolerance)
+	{
+		_tolerance = tolerance;
+	}
+	float getTolerance() const
+	{
+		return _tolerance;
+	}
+	// Stops splitting when the hull has this many points, 0 for no limit. Splits the farthest ranges
+	// first, which is done on one thread even in parallel mode. Counts under 3 are taken as 3
+	void setMaxVertexCount(size_t count)
+	{
+		_maxVertexCount = count;
+	}
+	size_t getMaxVertexCount() const
+	{
+		return _maxVertexCount;
+	}
+	// Every point was within this distance of the last run's hull, 0 when it is exact
+	double getApproximationError() const
+	{
+		return _approximationError;
+	}
+	// The number of points left for the first split in the last run, after culling
+	size_t getCandidateCount() const
+	{
+		return _candidateCount;
+	}
+
+	std::string getName() const override
+	{
+		std::string name = "QuickHullSoA";
+		if (std::is_same<Scalar, float>::value == false)
+			name += std::string("-") + Predicates::getName();
+		if (_parallel)
+			name += "-parallel";
+		if (_culling)
+			name += "-cull";
+		if (_tolerance > 0.0f)
+			name += "-tolerance";
+		if (_maxVertexCount > 0)
+			name += "-max" + std::to_string(_maxVertexCount);
+		return name;
+	}
+	bool computeHull(Points& points, std::vector<HullEdge>& edges, std::vector<HullEdge>* debugEdges = nullptr) override
+	{
+		return QuickHull(points, edges, debugEdges);
+	}
+
+	// #######################################################################################################
+	// QuickHull algorithm
+	// #######################################################################################################
+
+	// Returns true on complete
+	// Final hull edges are added to edges in counter clockwise order starting at the leftmost
+	// point, which is also the order of getHullOrder. When debugEdges is given, the first
+	// line that splits the points is added first followed by each A-C and C-B pair
+	bool QuickHull(Points& points, std::vector<HullEdge>& edges, std::vector<HullEdge>* debugEdges = nullptr)
+	{
+		HullProfiler::Scope runScope(_profiler, "QuickHullSoA");
+		points.clearOnHull();
+		_hullOrder.clear();
+		_approximationError = 0.0;
+		if (points.size() < 2)
+		{
+			if (points.size() == 1)
+				_hullOrder.push_back(0);
+			addHullEdges(points, edges);
+			return true;
+		}
+
+		const bool parallel = _parallel && points.size() >= _serialThreshold;
+		_buffer.resize(points.size());
+
+		// Least x value is left and greatest x value is right
+		Extremes extremes;
+		{
+			HullProfiler::Scope scope(_profiler, "min/max scan");
+			if (parallel)
+				findExtremesParallel(points, extremes);
+			else if (_culling)
+				_candidateCount = findExtremesAndCull(points, extremes);
+			else
+				findExtremes(points, 0, points.size(), extremes);
+		}
+		const uint32_t A = extremes._left;
+		const uint32_t B = extremes._right;
+
+		if (A == B)
+		{
+			_hullOrder.push_back(A);
+			addHullEdges(points, edges);
+			return true; // All points are the same
+		}
+
+		_debugEdges = debugEdges;
+		if (_debugEdges)
+			_debugEdges->push_back({ A, B });
+
+		// Split
+		SplitResult split;
+		{
+			HullProfiler::Scope scope(_profiler, "splitAllPoints");
+			int64_t splitStart = _profiler ? HullProfiler::now() : 0;
+			if (parallel)
+			{
+				CullPolygon polygon(points, extremes);
+				split = splitAllPointsParallel(points, A, B, _culling ? &polygon : nullptr);
+			}
+			else
+			{
+				if (_culling == false)
+					_candidateCount = copyAllPoints(points);
+				split = splitAllPoints(points, A, B, _candidateCount);
+			}
+			if (_profiler)
+			{
+				_profiler->addSplit(0, _candidateCount, split._firstCount, split._secondCount, HullProfiler::now() - splitStart);
+				_profiler->addCount("points", points.size());
+				_profiler->addCount("points in the first split", _candidateCount);
+			}
+		}
+
+		// A, the top chain, B, then the bottom chain
+		const size_t bottomOutput = split._firstCount + 2;
+		clearHullSlots(bottomOutput + split._secondCount);
+		_hullSlots[0] = A;
+		_hullSlots[bottomOutput - 1] = B;
+
+		// Begin recurse
+		if (_maxVertexCount > 0)
+		{
+			Frame top = { A, B, 0, split._firstCount, split._firstFarthest, 1, 1 };
+			Frame bottom = { B, A, split._firstCount, split._secondCount, split._secondFarthest, bottomOutput, 1 };
+			QuickHullGreedy(points, top, bottom);
+		}
+		else if (parallel)
+		{
+			TaskGroup tasks(TaskPool::getInstance());
+			_tasks = &tasks;
+			tasks.run([&]() { QuickHullSub(points, A, B, 0, split._firstCount, split._firstFarthest, 1, 1); }); // Top
+			QuickHullSub(points, B, A, split._firstCount, split._secondCount, split._secondFarthest, bottomOutput, 1); // Bottom
+			tasks.wait();
+			_tasks = nullptr;
+		}
+		else
+		{
+			QuickHullSub(points, A, B, 0, split._firstCount, split._firstFarthest, 1, 1); // Top
+			QuickHullSub(points, B, A, split._firstCount, split._secondCount, split._secondFarthest, bottomOutput, 1); // Bottom
+		}
+
+		// The slots are read here instead of writing the hull in the recursion,
+		// so tasks never write to the same output or on-hull bits word
+		for (size_t i = 0; i < bottomOutput + split._secondCount; i++)
+		{
+			if (_hullSlots[i] != _emptySlot)
+				_hullOrder.push_back(_hullSlots[i]);
+		}
+		{
+			HullProfiler::Scope scope(_profiler, "removeFlatVertices");
+			_hullOrder.resize(removeFlatHullVertices(_hullOrder.data(), _hullOrder.size(), [&points](uint32_t a, uint32_t b, uint32_t c)
+				{
+					return isFlatTurn(points, a, b, c);
+				}));
+		}
+		addHullEdges(points, edges);
+
+		_debugEdges = nullptr;
+		return true;
+	}
+
+private:
+	// A range of the buffer still to be split, the points in it are above A-B
+	struct Frame
+	{
+		uint32_t _A;
+		uint32_t _B;
+		size_t _rangeStart;
+		size_t _rangeCount;
+		size_t _farthestPoint; // Buffer position of the point farthest above A-B, found when the range was split
+		size_t _outputStart; // First of the _rangeCount hull slots for the hull points between A and B
+		size_t _depth; // Splits since the first one, for the profiler
+	};
+
+	// Works through the ranges left after a split with a fixed size stack instead of recursing
+	// The smaller of the two new ranges is done next and the larger one waits on the stack.
+	// The smaller one holds at most half of the points, so the stack never holds more than
+	// log2(n) frames no matter how many points are on the hull
+	void QuickHullSub(Points& points, uint32_t A, uint32_t B, size_t rangeStart, size_t rangeCount, size_t farthestPoint, size_t outputStart, size_t depth)
+	{
+		HullProfiler::Scope scope(_profiler, "QuickHullSub");
+		Frame stack[_maxStackDepth];
+		size_t stackSize = 0;
+
+		Frame frame = { A, B, rangeStart, rangeCount, farthestPoint, outputStart, depth };
+		while (true)
+		{
+			if (frame._rangeCount == 0)
+			{
+				addFinishedEdge(frame._A, frame._B);
+				if (stackSize == 0)
+					return;
+				frame = stack[--stackSize];
+				continue;
+			}
+
+			// Every point of the range is as close to A-B as the farthest one, so none of them are needed
+			if (_tolerance > 0.0f)
+			{
+				double distance = getDistance(points, frame._A, frame._B, _buffer._index[frame._farthestPoint]);
+				if (distance <= _tolerance)
+				{
+					addApproximationError(distance);
+					frame._rangeCount = 0;
+					continue;
+				}
+			}
+
+			Frame left, right;
+			splitFrame(points, frame, left, right);
+			if (left._rangeCount > right._rangeCount)
+				std::swap(left, right);
+
+			// Continue with the smaller side
+			if (_tasks && right._rangeCount >= _serialThreshold)
+			{
+				_tasks->run([=, &points]() {
+					QuickHullSub(points, right._A, right._B, right._rangeStart, right._rangeCount, right._farthestPoint, right._outputStart, right._depth);
+					});
+			}
+			else
+				stack[stackSize++] = right;
+			frame = left;
+		}
+	}
+	// Splits the range at its farthest point C, puts C in its slot and gives the ranges on either side of it
+	void splitFrame(Points& points, const Frame& frame, Frame& left, Frame& right)
+	{
+		uint32_t C = _buffer._index[frame._farthestPoint];
+
+		if (_debugEdges)
+		{
+			addEdge(*_debugEdges, frame._A, C);
+			addEdge(*_debugEdges, frame._B, C);
+		}
+
+		// Divide, the farthest points of the two sides are found in the same pass
+		int64_t splitStart = _profiler ? HullProfiler::now() : 0;
+		auto split = splitPoints(points, frame._A, frame._B, C, frame._rangeStart, frame._rangeCount);
+		if (_profiler)
+			_profiler->addSplit(frame._depth, frame._rangeCount, split._firstCount, split._secondCount, HullProfiler::now() - splitStart);
+		left = { frame._A, C, frame._rangeStart, split._firstCount, frame._rangeStart + split._firstFarthest,
+			frame._outputStart, frame._depth + 1 };
+		right = { C, frame._B, frame._rangeStart + split._firstCount, split._secondCount, frame._rangeStart + split._secondFarthest,
+			frame._outputStart + split._firstCount + 1, frame._depth + 1 };
+
+		// C is on neither side, so both sides and C fit in this range's slots
+		_hullSlots[frame._outputStart + split._firstCount] = C;
+	}
+
+	// Splits the range with the farthest point from its line first, until the hull has _maxVertexCount
+	// points or every range left is within the tolerance. The farthest range left is the error.
+	// Which range is next depends on all of them, so this is not split into tasks
+	void QuickHullGreedy(Points& points, const Frame& top, const Frame& bottom)
+	{
+		HullProfiler::Scope scope(_profiler, "QuickHullGreedy");
+		_pendingRanges.clear();
+		addPendingRange(points, top);
+		addPendingRange(points, bottom);
+
+		const size_t maxVertexCount = std::max(_maxVertexCount, size_t(3));
+		size_t vertexCount = 2; // A and B
+		while (_pendingRanges.empty() == false)
+		{
+			if (vertexCount >= maxVertexCount || _pendingRanges.front()._distance <= _tolerance)
+				break;
+			Frame frame = _pendingRanges.front()._frame;
+			std::pop_heap(_pendingRanges.begin(), _pendingRanges.end());
+			_pendingRanges.pop_back();
+
+			Frame left, right;
+			splitFrame(points, frame, left, right);
+			vertexCount++;
+			addPendingRange(points, left);
+			addPendingRange(points, right);
+		}
+		if (_pendingRanges.empty() == false)
+			addApproximationError(_pendingRanges.front()._distance);
+		for (const PendingRange& range : _pendingRanges)
+			addFinishedEdge(range._frame._A, range._frame._B);
+	}
+	void addPendingRange(const Points& points, const Frame& frame)
+	{
+		if (frame._rangeCount == 0)
+		{
+			addFinishedEdge(frame._A, frame._B);
+			return;
+		}
+		double distance = getDistance(points, frame._A, frame._B, _buffer._index[frame._farthestPoint]);
+		_pendingRanges.push_back({ frame, distance });
+		std::push_heap(_pendingRanges.begin(), _pendingRanges.end());
+	}
+
+	// Distance of C from the line through A and B
+	static double getDistance(const Points& points, uint32_t A, uint32_t B, uint32_t C)
+	{
+		double abx = double(points._x[B]) - points._x[A];
+		double aby = double(points._y[B]) - points._y[A];
+		double acx = double(points._x[C]) - points._x[A];
+		double acy = double(points._y[C]) - points._y[A];
+		return std::fabs(abx * acy - aby * acx) / std::sqrt(abx * abx + aby * aby);
+	}
+	void addApproximationError(double distance)
+	{
+		if (_tasks)
+		{
+			std::lock_guard<std::mutex> lock(_outputLock);
+			_approximationError = std::max(_approximationError, distance);
+		}
+		else
+			_approximationError = std::max(_approximationError, distance);
+	}
+
+	// Marks the first count slots as empty, the slots are kept between runs
+	void clearHullSlots(size_t count)
+	{
+		if (_hullSlots.size() < count)
+			_hullSlots.resize(count);
+		std::fill(_hullSlots.begin(), _hullSlots.begin() + count, _emptySlot);
+	}
+	// The farthest point is picked from rounded side values, so when points are in line (or nearly)
+	// with a hull edge it can be one that is not a corner of the hull. A is always a corner, so the
+	// hull is walked from it. The top chain runs from A to B above A-B, which turns the hull counter
+	// clockwise by the orientation test, so anything else is not a corner
+	static bool isFlatTurn(const Points& points, uint32_t a, uint32_t b, uint32_t c)
+	{
+		return Predicates::orientation(points._x[a], points._y[a], points._x[b], points._y[b], points._x[c], points._y[c]) <= 0.0;
+	}
+
+	void addEdge(std::vector<HullEdge>& edges, uint32_t A, uint32_t B)
+	{
+		if (_tasks)
+		{
+			std::lock_guard<std::mutex> lock(_outputLock);
+			edges.push_back({ A, B });
+		}
+		else
+			edges.push_back({ A, B });
+	}
+
+	// No points are above A-B, or none that are kept, so it is an edge of the hull
+	// The queue takes one pushing thread at a time, so parallel tasks take turns
+	void addFinishedEdge(uint32_t A, uint32_t B)
+	{
+		if (_progressQueue == nullptr)
+			return;
+		if (_tasks)
+		{
+			std::lock_guard<std::mutex> lock(_outputLock);
+			addProgressEdge(A, B);
+		}
+		else
+			addProgressEdge(A, B);
+	}
+
+	// Moves the extremes to point i when it is further out, returns true if any of them moved
+	// Ties are broken on the other axis, so left and right are only the same point when all points are
+	static bool updateExtremes(const Scalar* x, const Scalar* y, uint32_t i, Extremes& extremes)
+	{
+		bool moved = false;
+		if (x[i] < x[extremes._left] || (x[i] == x[extremes._left] && y[i] < y[extremes._left]))
+		{
+			extremes._left = i; // Set min point
+			moved = true;
+		}
+		if (x[i] > x[extremes._right] || (x[i] == x[extremes._right] && y[i] > y[extremes._right]))
+		{
+			extremes._right = i; // Set max point
+			moved = true;
+		}
+		if (y[i] < y[extremes._bottom] || (y[i] == y[extremes._bottom] && x[i] > x[extremes._bottom]))
+		{
+			extremes._bottom = i;
+			moved = true;
+		}
+		if (y[i] > y[extremes._top] || (y[i] == y[extremes._top] && x[i] < x[extremes._top]))
+		{
+			extremes._top = i;
+			moved = true;
+		}
+		// Sums and differences of int32_t coordinates are taken in 64 bits so they can not overflow
+		using Wide = typename std::conditional<std::is_integral<Scalar>::value, int64_t, Scalar>::type;
+		const Wide sum = Wide(x[i]) + y[i];
+		const Wide difference = Wide(x[i]) - y[i];
+		if (sum < Wide(x[extremes._leastSum]) + y[extremes._leastSum])
+		{
+			extremes._leastSum = i;
+			moved = true;
+		}
+		if (sum > Wide(x[extremes._greatestSum]) + y[extremes._greatestSum])
+		{
+			extremes._greatestSum = i;
+			moved = true;
+		}
+		if (difference < Wide(x[extremes._leastDifference]) - y[extremes._leastDifference])
+		{
+			extremes._leastDifference = i;
+			moved = true;
+		}
+		if (difference > Wide(x[extremes._greatestDifference]) - y[extremes._greatestDifference])
+		{
+			extremes._greatestDifference = i;
+			moved = true;
+		}
+		return moved;
+	}
+	static void findExtremes(const Points& points, size_t rangeStart, size_t rangeEnd, Extremes& extremes)
+	{
+		const Scalar* x = points._x.data();
+		const Scalar* y = points._y.data();
+
+		uint32_t first = uint32_t(rangeStart);
+		extremes = { first, first, first, first, first, first, first, first };
+		for (size_t i = rangeStart + 1; i < rangeEnd; i++)
+			updateExtremes(x, y, uint32_t(i), extremes);
+	}
+	// findExtremes that also copies the points to the buffer, leaving out the points
+	// strictly inside the polygon of the extremes found so far
+	// Returns the number of points copied
+	size_t findExtremesAndCull(const Points& points, Extremes& extremes)
+	{
+		const Scalar* x = points._x.data();
+		const Scalar* y = points._y.data();
+
+		extremes = Extremes();
+		CullPolygon polygon(points, extremes);
+		size_t candidateCount = 0;
+		for (size_t i = 0; i < points.size(); i++)
+		{
+			if (updateExtremes(x, y, uint32_t(i), extremes))
+				polygon = CullPolygon(points, extremes);
+			else if (polygon.contains(x[i], y[i]))
+				continue; // Can not be on the hull
+
+			_buffer._x[candidateCount] = x[i];
+			_buffer._y[candidateCount] = y[i];
+			_buffer._index[candidateCount] = uint32_t(i);
+			candidateCount++;
+		}
+		return candidateCount;
+	}
+	void findExtremesParallel(const Points& points, Extremes& extremes)
+	{
+		TaskPool& pool = TaskPool::getInstance();
+		_chunks.resize(pool.getThreadCount() * 4);
+
+		pool.parallelFor(points.size(), _chunks.size(), [&](size_t chunk, size_t begin, size_t end) {
+			findExtremes(points, begin, end, _chunks[chunk]._extremes);
+			});
+
+		// Reduce
+		const Scalar* x = points._x.data();
+		const Scalar* y = points._y.data();
+		extremes = _chunks[0]._extremes;
+		for (size_t chunk = 1; chunk < chunkCount(points.size()); chunk++)
+		{
+			const Extremes& chunkExtremes = _chunks[chunk]._extremes;
+			updateExtremes(x, y, chunkExtremes._left, extremes);
+			updateExtremes(x, y, chunkExtremes._right, extremes);
+			updateExtremes(x, y, chunkExtremes._bottom, extremes);
+			updateExtremes(x, y, chunkExtremes._top, extremes);
+			updateExtremes(x, y, chunkExtremes._leastSum, extremes);
+			updateExtremes(x, y, chunkExtremes._greatestSum, extremes);
+			updateExtremes(x, y, chunkExtremes._leastDifference, extremes);
+			updateExtremes(x, y, chunkExtremes._greatestDifference, extremes);
+		}
+	}
+	// The number of chunks parallelFor actually uses for the count
+	size_t chunkCount(size_t count) const
+	{
+		size_t chunkSize = (count + _chunks.size() - 1) / _chunks.size();
+		return (count + chunkSize - 1) / chunkSize;
+	}
+
+	static Line getLine(const Points& points, uint32_t A, uint32_t B)
+	{
+		return Line(points._x[A], points._y[A], points._x[B], points._y[B]);
+	}
+
+	// Returns the number of points copied
+	size_t copyAllPoints(const Points& points)
+	{
+		std::copy(points._x.begin(), points._x.end(), _buffer._x.begin());
+		std::copy(points._y.begin(), points._y.end(), _buffer._y.begin());
+		std::iota(_buffer._index.begin(), _buffer._index.end(), uint32_t(0));
+		return points.size();
+	}
+	// Moves the points at the front of the buffer that are above A-B to the front of
+	// it followed by the points below
+	SplitResult splitAllPoints(const Points& points, uint32_t A, uint32_t B, size_t candidateCount)
+	{
+		// Below A-B is above B-A. The points on the line, which includes A and B, are dropped
+		return HullKernels::splitAboveLines(_buffer._x.data(), _buffer._y.data(), _buffer._index.data(), candidateCount,
+			getLine(points, A, B), getLine(points, B, A));
+	}
+	// Same as copying and splitting all the points, in two parallel passes. The first counts
+	// the points above and below in each chunk, the second copies them straight to their
+	// final slots. Points inside the polygon are left out when one is given
+	SplitResult splitAllPointsParallel(const Points& points, uint32_t A, uint32_t B, const CullPolygon* polygon)
+	{
+		TaskPool& pool = TaskPool::getInstance();
+		const Scalar* x = points._x.data();
+		const Scalar* y = points._y.data();
+		const Line above = getLine(points, A, B);
+		const Line below = getLine(points, B, A);
+
+		// Count
+		pool.parallelFor(points.size(), _chunks.size(), [&](size_t chunk, size_t begin, size_t end) {
+			Chunk& result = _chunks[chunk];
+			result._candidateCount = 0;
+			result._aboveCount = 0;
+			result._belowCount = 0;
+			result._aboveFarthestSide = 0;
+			result._belowFarthestSide = 0;
+			for (size_t i = begin; i < end; i++)
+			{
+				if (polygon && polygon->contains(x[i], y[i]))
+					continue;
+				result._candidateCount++;
+
+				Side side = above.side(x[i], y[i]);
+				if (side > 0)
+				{
+					result._aboveCount++;
+					if (side > result._aboveFarthestSide)
+					{
+						result._aboveFarthestSide = side;
+						result._aboveFarthest = uint32_t(i);
+					}
+					continue;
+				}
+				side = below.side(x[i], y[i]);
+				if (side > 0)
+				{
+					result._belowCount++;
+					if (side > result._belowFarthestSide)
+					{
+						result._belowFarthestSide = side;
+						result._belowFarthest = uint32_t(i);
+					}
+				}
+			}
+			});
+
+		// Work out where each chunk writes to and which point is farthest overall
+		const size_t usedChunks = chunkCount(points.size());
+		size_t aboveTotal = 0;
+		size_t belowTotal = 0;
+		for (size_t chunk = 0; chunk < usedChunks; chunk++)
+			aboveTotal += _chunks[chunk]._aboveCount;
+
+		Side aboveFarthestSide = 0;
+		Side belowFarthestSide = 0;
+		uint32_t aboveFarthest = 0;
+		uint32_t belowFarthest = 0;
+		size_t aboveOffset = 0;
+		_candidateCount = 0;
+		for (size_t chunk = 0; chunk < usedChunks; chunk++)
+		{
+			Chunk& result = _chunks[chunk];
+			_candidateCount += result._candidateCount;
+			result._aboveOffset = aboveOffset;
+			result._belowOffset = aboveTotal + belowTotal;
+			aboveOffset += result._aboveCount;
+			belowTotal += result._belowCount;
+
+			if (result._aboveCount > 0 && result._aboveFarthestSide > aboveFarthestSide)
+			{
+				aboveFarthestSide = result._aboveFarthestSide;
+				aboveFarthest = result._aboveFarthest;
+			}
+			if (result._belowCount > 0 && result._belowFarthestSide > belowFarthestSide)
+			{
+				belowFarthestSide = result._belowFarthestSide;
+				belowFarthest = result._belowFarthest;
+			}
+		}
+
+		// Copy
+		SplitResult split;
+		split._firstCount = aboveTotal;
+		split._secondCount = belowTotal;
+		pool.parallelFor(points.size(), _chunks.size(), [&](size_t chunk, size_t begin, size_t end) {
+			size_t aboveSlot = _chunks[chunk]._aboveOffset;
+			size_t belowSlot = _chunks[chunk]._belowOffset;
+			for (size_t i = begin; i < end; i++)
+			{
+				if (polygon && polygon->contains(x[i], y[i]))
+					continue;
+
+				size_t slot;
+				if (above.side(x[i], y[i]) > 0)
+				{
+					slot = aboveSlot++;
+					if (i == aboveFarthest)
+						split._firstFarthest = slot;
+				}
+				else if (below.side(x[i], y[i]) > 0)
+				{
+					slot = belowSlot++;
+					if (i == belowFarthest)
+						split._secondFarthest = slot;
+				}
+				else
+					continue;
+				_buffer._x[slot] = x[i];
+				_buffer._y[slot] = y[i];
+				_buffer._index[slot] = uint32_t(i);
+			}
+			});
+		return split;
+	}
+	// Reorders the range so the points above A-C come first, followed by the
+	// points above C-B. The points inside the triangle A-B-C are dropped
+	SplitResult splitPoints(const Points& points, uint32_t A, uint32_t B, uint32_t C, size_t rangeStart, size_t rangeCount)
+	{
+		return HullKernels::splitAboveLines(_buffer._x.data() + rangeStart, _buffer._y.data() + rangeStart, _buffer._index.data() + rangeStart, rangeCount,
+			getLine(points, A, C), getLine(points, C, B));
+	}
+
+	// #######################################################################################################
+	// END QuickHull algorithm and helpers
+	// #######################################################################################################
+
+private:
+	// Per chunk results of the parallel passes
+	struct Chunk
+	{
+		Extremes _extremes;
+		size_t _candidateCount = 0;
+		size_t _aboveCount = 0;
+		size_t _belowCount = 0;
+		Side _aboveFarthestSide = 0;
+		Side _belowFarthestSide = 0;
+		uint32_t _aboveFarthest = 0;
+		uint32_t _belowFarthest = 0;
+		size_t _aboveOffset = 0;
+		size_t _belowOffset = 0;
+	};
+
+	// A range waiting in the heap of QuickHullGreedy, the one with the farthest point is on top
+	struct PendingRange
+	{
+		Frame _frame;
+		double _distance;
+
+		bool operator<(const PendingRange& other) const
+		{
+			return _distance < other._distance;
+		}
+	};
+
+private:
+	Buffer _buffer;
+
+	// Culling
+	bool _culling = false;
+	size_t _candidateCount = 0;
+
+	// Approximation
+	float _tolerance = 0.0f;
+	size_t _maxVertexCount = 0;
+	double _approximationError = 0.0;
+	std::vector<PendingRange> _pendingRanges; // Kept between runs
+
+	// Enough for the log2(n) frames of any range a uint32_t can index
+	static constexpr size_t _maxStackDepth = 64;
+
+	// Parallel mode
+	bool _parallel = false;
+	size_t _serialThreshold = 1 << 14; // Ranges smaller than this are not worth a task
+	std::vector<Chunk> _chunks;
+	TaskGroup* _tasks = nullptr;
+	std::mutex _outputLock;
+
+	// Outputs for the run in progress
+	static constexpr uint32_t _emptySlot = 0xFFFFFFFF;
+	std::vector<uint32_t> _hullSlots; // Hull points in order with gaps between them
+	std::vector<HullEdge>* _debugEdges = nullptr;
+};
+
+using QuickHullSoA = BasicQuickHullSoA<float>;
@@ -0,0 +1,80 @@
+// SpscQueue.h
+// Nathan Damon
+// 2026-10-16
+// Lock-free queue for one thread to hand items to one other thread
+//
+// A fixed size ring with a write position moved only by the pushing thread
+// and a read position moved only by the popping thread, so neither needs a
+// lock. Each side publishes its position with a release store and reads
+// the other's with an acquire load. Each side also keeps the last position
+// it read from the other one, so it only touches the other side's cache
+// line when the ring looks full or empty. Pushing never waits, a full
+// queue turns the item away.
+
+#pragma once
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+template <typename T>
+class SpscQueue
+{
+public:
+	// The capacity is rounded up to a power of two
+	SpscQueue(size_t capacity)
+	{
+		size_t size = 1;
+		while (size < capacity)
+			size <<= 1;
+		_items.resize(size);
+		_mask = size - 1;
+	}
+	~SpscQueue() {}
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	// Pushing thread only, returns false when the queue is full
+	bool tryPush(const T& item)
+	{
+		size_t write = _write.load(std::memory_order_relaxed);
+		if (write - _cachedRead == _items.size())
+		{
+			_cachedRead = _read.load(std::memory_order_acquire);
+			if (write - _cachedRead == _items.size())
+				return false;
+		}
+		_items[write & _mask] = item;
+		_write.store(write + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Popping thread only, returns false when the queue is empty
+	bool tryPop(T& item)
+	{
+		size_t read = _read.load(std::memory_order_relaxed);
+		if (read == _cachedWrite)
+		{
+			_cachedWrite = _write.load(std::memory_order_acquire);
+			if (read == _cachedWrite)
+				return false;
+		}
+		item = _items[read & _mask];
+		_read.store(read + 1, std::memory_order_release);
+		return true;
+	}
+
+	size_t capacity() const
+	{
+		return _items.size();
+	}
+
+private:
+	std::vector<T> _items;
+	size_t _mask = 0;
+
+	// The positions only count up and are masked into the ring, so a full ring is not mistaken for an empty one
+	alignas(64) std::atomic<size_t> _write{ 0 };
+	size_t _cachedRead = 0; // The pushing thread's copy of _read
+	alignas(64) std::atomic<size_t> _read{ 0 };
+	size_t _cachedWrite = 0; // The popping thread's copy of _write
+};
@@ -0,0 +1,215 @@
+// StreamingHull.h
+// Nathan Damon
+// 2026-10-16
+// Convex hull of a file of points too large to hold in memory
+//
+// The file is a flat run of x, y pairs, either 32 bit or 64 bit floats in
+// the machine's byte order, with nothing before or after them. It is
+// memory mapped and split into chunks of a fixed number of points, and
+// each chunk is its own task on the TaskPool: its points are copied into
+// a chunk sized BasicHullPoints of the file's type, BasicQuickHullSoA is
+// run on them and only the chunk's hull points are kept, along with where
+// in the file they came from. The chunk's pages are then released. Once
+// every chunk is done, the kept points are merged with one more hull run
+// in double, which holds the values of either format exactly.
+//
+// The memory used is a chunk's worth of points for each thread plus the
+// kept points, so it grows with the hull sizes and not with the file.
+// getHull rounds the hull to float for drawing, the file index of each
+// hull point is kept so its exact coordinates can be read back.
+
+#pragma once
+#include "HullPoints.h"
+#include "QuickHullSoA.h"
+#include "MappedFile.h"
+#include "TaskPool.h"
+#include <fstream>
+#include <mutex>
+#include <cstring>
+
+class StreamingHull
+{
+public:
+	enum class Format
+	{
+		Float32,	// x and y as 32 bit floats, 8 bytes a point
+		Float64		// x and y as 64 bit floats, 16 bytes a point
+	};
+
+	// A hull point of a chunk
+	struct Candidate
+	{
+		double _x;
+		double _y;
+		uint64_t _fileIndex;
+	};
+
+public:
+	StreamingHull() {}
+	~StreamingHull() {}
+
+	// Returns false when the file could not be read, getError says why
+	// The hull is put in getHull in counter clockwise order
+	bool computeHull(const std::string& fileName, Format format)
+	{
+		_hull.resize(0);
+		_hullIndices.clear();
+		_candidates.clear();
+		_pointCount = 0;
+		_chunkCount = 0;
+		_error.clear();
+
+		MappedFile file;
+		if (file.open(fileName) == false)
+		{
+			_error = "could not open the file";
+			return false;
+		}
+		size_t pointSize = getPointSize(format);
+		if (file.getSize() % pointSize != 0)
+		{
+			_error = "the file size is not a whole number of points";
+			return false;
+		}
+		_pointCount = file.getSize() / pointSize;
+		_chunkCount = (_pointCount + _chunkSize - 1) / _chunkSize;
+
+		// One task for each chunk, the hull engines and points of a chunk only last as long as its task
+		std::mutex candidatesLock;
+		TaskPool::getInstance().parallelFor(_chunkCount, _chunkCount, [&](size_t chunkIndex, size_t firstChunk, size_t endChunk)
+			{
+				(void)chunkIndex;
+				for (size_t chunk = firstChunk; chunk < endChunk; chunk++)
+				{
+					size_t begin = chunk * _chunkSize;
+					size_t end = std::min(_pointCount, begin + _chunkSize);
+					if (format == Format::Float32)
+						hullChunk<float>(file.getData(), begin, end, candidatesLock);
+					else
+						hullChunk<double>(file.getData(), begin, end, candidatesLock);
+					file.release(begin * pointSize, (end - begin) * pointSize);
+				}
+			});
+
+		// The chunks finish in any order, sorting by file index makes the result the same every time
+		std::sort(_candidates.begin(), _candidates.end(), [](const Candidate& a, const Candidate& b) { return a._fileIndex < b._fileIndex; });
+		_mergePoints.resize(_candidates.size());
+		for (size_t i = 0; i < _candidates.size(); i++)
+			_mergePoints.setPoint(i, _candidates[i]._x, _candidates[i]._y);
+		_mergeEdges.clear();
+		_mergeHull.computeHull(_mergePoints, _mergeEdges);
+
+		const std::vector<uint32_t>& order = _mergeHull.getHullOrder();
+		_hull.resize(order.size());
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			const Candidate& candidate = _candidates[order[i]];
+			_hull.setPoint(i, float(candidate._x), float(candidate._y));
+			_hullIndices.push_back(candidate._fileIndex);
+		}
+		return true;
+	}
+
+	// Hull points of the last run in counter clockwise order, rounded to float
+	const HullPoints& getHull() const
+	{
+		return _hull;
+	}
+	// Index in the file of each hull point
+	const std::vector<uint64_t>& getHullIndices() const
+	{
+		return _hullIndices;
+	}
+	size_t getPointCount() const
+	{
+		return _pointCount;
+	}
+	size_t getChunkCount() const
+	{
+		return _chunkCount;
+	}
+	// Hull points of all the chunks, the points given to the final merge
+	size_t getCandidateCount() const
+	{
+		return _candidates.size();
+	}
+	const std::string& getError() const
+	{
+		return _error;
+	}
+
+	// Points read by each task, which with the thread count sets the memory used
+	void setChunkSize(size_t pointCount)
+	{
+		_chunkSize = std::max(size_t(1), pointCount);
+	}
+	size_t getChunkSize() const
+	{
+		return _chunkSize;
+	}
+
+	static size_t getPointSize(Format format)
+	{
+		return format == Format::Float32 ? 2 * sizeof(float) : 2 * sizeof(double);
+	}
+
+	// Writes points as a file computeHull can read, returns false when it could not be written
+	static bool writePoints(const std::string& fileName, const HullPoints& points, Format format)
+	{
+		std::ofstream out(fileName, std::ios::binary);
+		if (out.is_open() == false)
+			return false;
+		for (size_t i = 0; i < points.size(); i++)
+		{
+			if (format == Format::Float32)
+			{
+				const float xy[2] = { points._x[i], points._y[i] };
+				out.write(reinterpret_cast<const char*>(xy), sizeof(xy));
+			}
+			else
+			{
+				const double xy[2] = { points._x[i], points._y[i] };
+				out.write(reinterpret_cast<const char*>(xy), sizeof(xy));
+			}
+		}
+		return bool(out);
+	}
+
+private:
+	// Runs QuickHull on points begin to end of the file, which are Scalar pairs, and adds its hull points to the candidates
+	template <typename Scalar>
+	void hullChunk(const uint8_t* data, size_t begin, size_t end, std::mutex& candidatesLock)
+	{
+		// The mapped data has no alignment to rely on
+		BasicHullPoints<Scalar> points(end - begin);
+		for (size_t i = begin; i < end; i++)
+		{
+			Scalar xy[2];
+			std::memcpy(xy, data + i * sizeof(xy), sizeof(xy));
+			points.setPoint(i - begin, xy[0], xy[1]);
+		}
+
+		BasicQuickHullSoA<Scalar> quickHull;
+		quickHull.setCulling(true);
+		std::vector<HullEdge> edges;
+		quickHull.computeHull(points, edges);
+
+		std::lock_guard<std::mutex> lock(candidatesLock);
+		for (uint32_t index : quickHull.getHullOrder())
+			_candidates.push_back({ double(points._x[index]), double(points._y[index]), begin + index });
+	}
+
+private:
+	size_t _chunkSize = size_t(1) << 20;
+	size_t _pointCount = 0;
+	size_t _chunkCount = 0;
+	std::string _error;
+
+	std::vector<Candidate> _candidates;
+	BasicHullPoints<double> _mergePoints;
+	std::vector<HullEdge> _mergeEdges;
+	BasicQuickHullSoA<double> _mergeHull;
+
+	HullPoints _hull;
+	std::vector<uint64_t> _hullIndices;
+};
@@ -0,0 +1,223 @@
+// TaskPool.h
+// Nathan Damon
+// 2026-10-16
+// A small work-stealing thread pool
+//
+// Every worker has its own queue. A worker takes the newest task from its
+// own queue and, when that is empty, steals the oldest task from another
+// queue. Threads that are not workers push to a shared queue. A thread
+// waiting on a TaskGroup runs queued tasks while it waits, so tasks can
+// start more tasks and wait on them without running out of threads.
+
+#pragma once
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <algorithm>
+
+class TaskPool
+{
+public:
+	using Task = std::function<void()>;
+
+public:
+	// threadCount includes the thread that waits on the work, so one less worker is started
+	TaskPool(unsigned threadCount = std::thread::hardware_concurrency())
+	{
+		_threadCount = std::max(1u, threadCount);
+		_queues.resize(_threadCount);
+		for (auto& queue : _queues)
+			queue = std::make_unique<WorkQueue>();
+
+		for (unsigned i = 0; i + 1 < _threadCount; i++)
+			_workers.push_back(std::thread([this, i]() { workerLoop(i); }));
+	}
+	~TaskPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_sleepLock);
+			_stopping = true;
+		}
+		_wake.notify_all();
+		for (auto& worker : _workers)
+			worker.join();
+	}
+
+	// Shared pool sized to the machine
+	static TaskPool& getInstance()
+	{
+		static TaskPool pool;
+		return pool;
+	}
+
+	unsigned getThreadCount() const
+	{
+		return _threadCount;
+	}
+
+	void push(Task task)
+	{
+		WorkQueue& queue = *_queues[getQueueIndex()];
+		{
+			std::lock_guard<std::mutex> lock(queue._lock);
+			queue._tasks.push_back(std::move(task));
+		}
+		_queuedTasks++;
+		{
+			std::lock_guard<std::mutex> lock(_sleepLock);
+		}
+		_wake.notify_one();
+	}
+
+	// Runs one queued task, returns false when there was nothing to run
+	bool runPendingTask()
+	{
+		Task task;
+		if (popTask(task) == false)
+			return false;
+		task();
+		return true;
+	}
+
+	// Splits [0, count) into about chunkCount pieces and runs body(chunkIndex, begin, end)
+	// for each of them on the pool, returning when they are all done
+	template<typename Function>
+	void parallelFor(size_t count, size_t chunkCount, Function&& body);
+
+private:
+	struct WorkQueue
+	{
+		std::mutex _lock;
+		std::deque<Task> _tasks;
+	};
+
+	static int& workerIndex()
+	{
+		static thread_local int index = -1;
+		return index;
+	}
+	size_t getQueueIndex() const
+	{
+		// Threads that are not workers share the last queue
+		int index = workerIndex();
+		return index >= 0 ? size_t(index) : _queues.size() - 1;
+	}
+
+	bool popTask(Task& task)
+	{
+		if (_queuedTasks.load() == 0)
+			return false;
+
+		// Newest task from our own queue first
+		size_t own = getQueueIndex();
+		{
+			WorkQueue& queue = *_queues[own];
+			std::lock_guard<std::mutex> lock(queue._lock);
+			if (queue._tasks.empty() == false)
+			{
+				task = std::move(queue._tasks.back());
+				queue._tasks.pop_back();
+				_queuedTasks--;
+				return true;
+			}
+		}
+		// Then steal the oldest task from someone else
+		for (size_t i = 1; i < _queues.size(); i++)
+		{
+			WorkQueue& queue = *_queues[(own + i) % _queues.size()];
+			std::lock_guard<std::mutex> lock(queue._lock);
+			if (queue._tasks.empty() == false)
+			{
+				task = std::move(queue._tasks.front());
+				queue._tasks.pop_front();
+				_queuedTasks--;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void workerLoop(unsigned index)
+	{
+		workerIndex() = int(index);
+		while (true)
+		{
+			if (runPendingTask())
+				continue;
+
+			std::unique_lock<std::mutex> lock(_sleepLock);
+			_wake.wait(lock, [this]() { return _stopping || _queuedTasks.load() > 0; });
+			if (_stopping)
+				return;
+		}
+	}
+
+private:
+	unsigned _threadCount = 1;
+	std::vector<std::unique_ptr<WorkQueue>> _queues;
+	std::vector<std::thread> _workers;
+
+	std::atomic<size_t> _queuedTasks{ 0 };
+	std::mutex _sleepLock;
+	std::condition_variable _wake;
+	bool _stopping = false;
+};
+
+// Tasks that are waited on together
+class TaskGroup
+{
+public:
+	TaskGroup(TaskPool& pool) : _pool(pool) {}
+	~TaskGroup()
+	{
+		wait();
+	}
+
+	void run(TaskPool::Task task)
+	{
+		_pending++;
+		_pool.push([this, task = std::move(task)]() {
+			task();
+			_pending--;
+			});
+	}
+	// Helps run queued tasks until every task of this group is done
+	void wait()
+	{
+		while (_pending.load() > 0)
+		{
+			if (_pool.runPendingTask() == false)
+				std::this_thread::yield();
+		}
+	}
+
+private:
+	TaskPool& _pool;
+	std::atomic<size_t> _pending{ 0 };
+};
+
+template<typename Function>
+void TaskPool::parallelFor(size_t count, size_t chunkCount, Function&& body)
+{
+	if (count == 0)
+		return;
+	chunkCount = std::max<size_t>(1, std::min(chunkCount, count));
+	size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+	chunkCount = (count + chunkSize - 1) / chunkSize;
+
+	TaskGroup tasks(*this);
+	for (size_t chunk = 1; chunk < chunkCount; chunk++)
+	{
+		size_t begin = chunk * chunkSize;
+		size_t end = std::min(count, begin + chunkSize);
+		tasks.run([&body, chunk, begin, end]() { body(chunk, begin, end); });
+	}
+	// The first chunk is run here
+	body(0, 0, std::min(count, chunkSize));
+	tasks.wait();
+}
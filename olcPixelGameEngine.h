@@ -1080,6 +1080,9 @@ namespace olc
 		// Draws a single Pixel
 		virtual bool Draw(int32_t x, int32_t y, Pixel p = olc::WHITE);
 		bool Draw(const olc::vi2d& pos, Pixel p = olc::WHITE);
+		// Draws count Pixels of one colour at (x[i],y[i]) * scale + offset. The draw target,
+		// its bounds and the pixel mode are looked at once for all of them, not per Pixel
+		void DrawPoints(const float* x, const float* y, size_t count, Pixel p = olc::WHITE, float scale = 1.0f, const olc::vf2d& offset = { 0.0f, 0.0f });
 		// Draws a line from (x1,y1) to (x2,y2)
 		void DrawLine(int32_t x1, int32_t y1, int32_t x2, int32_t y2, Pixel p = olc::WHITE, uint32_t pattern = 0xFFFFFFFF);
 		void DrawLine(const olc::vi2d& pos1, const olc::vi2d& pos2, Pixel p = olc::WHITE, uint32_t pattern = 0xFFFFFFFF);
@@ -2279,6 +2282,33 @@ namespace olc
 		return false;
 	}
 
+	void PixelGameEngine::DrawPoints(const float* x, const float* y, size_t count, Pixel p, float scale, const olc::vf2d& offset)
+	{
+		if (!pDrawTarget) return;
+
+		// Blending reads the target for every Pixel, so those modes go through Draw
+		if (nPixelMode == Pixel::ALPHA || nPixelMode == Pixel::CUSTOM)
+		{
+			for (size_t i = 0; i < count; i++)
+				Draw(int32_t(x[i] * scale + offset.x), int32_t(y[i] * scale + offset.y), p);
+			return;
+		}
+		if (nPixelMode == Pixel::MASK && p.a != 255)
+			return;
+
+		Pixel* data = pDrawTarget->GetData();
+		const uint32_t width = uint32_t(pDrawTarget->width);
+		const uint32_t height = uint32_t(pDrawTarget->height);
+		for (size_t i = 0; i < count; i++)
+		{
+			int32_t px = int32_t(x[i] * scale + offset.x);
+			int32_t py = int32_t(y[i] * scale + offset.y);
+			// Negative values become large when unsigned, so one compare clips both sides
+			if (uint32_t(px) < width && uint32_t(py) < height)
+				data[size_t(py) * width + px] = p;
+		}
+	}
+
 
 	void PixelGameEngine::DrawLine(const olc::vi2d& pos1, const olc::vi2d& pos2, Pixel p, uint32_t pattern)
 	{